@@ -0,0 +1,449 @@
+// AgentSimulation.cpp
+
+#include "AgentSimulation.h"
+#include "Heuristic.h"
+#include <algorithm>
+#include <chrono>
+#include <limits.h>
+#include <stddef.h>
+
+// Number of agents handed to a worker at a time when moving them; moving an agent is cheap, so tasks need plenty of them to be worth it
+const int AGENTS_PER_TASK = 512;
+
+// Ticks an agent waits behind other agents before stepping aside, unless changed
+const int DEFAULT_PATIENCE = 4;
+
+AgentSimulation::AgentSimulation(Grid* grid, int threadCount, int cacheCapacity) : pathfinder(grid, threadCount), cache(grid, cacheCapacity), claims(grid->GetCellCount())
+{
+
+	this->grid = grid;
+
+	useCache = cacheCapacity > 0;
+	pathfinder.SetPathCache(useCache ? &cache : NULL);
+
+	occupants.assign(grid->GetCellCount(), -1);
+
+	for (int i = 0; i < grid->GetCellCount(); i++)
+	{
+
+		claims[i].store(INT_MAX, std::memory_order_relaxed);
+
+	}
+
+	patience = DEFAULT_PATIENCE;
+
+	stats.ticks = 0;
+	stats.moves = 0;
+	stats.blocks = 0;
+	stats.pathRequests = 0;
+	stats.cacheHits = 0;
+	stats.arrivals = 0;
+	stats.pathNanoseconds = 0;
+	stats.moveNanoseconds = 0;
+
+}
+
+AgentSimulation::~AgentSimulation()
+{
+
+	grid = NULL;
+
+}
+
+// Add an agent on a passable, empty cell
+int AgentSimulation::AddAgent(int cell, int goal)
+{
+
+	if (grid->IsObstacle(cell) || occupants[cell] != -1)
+	{
+
+		return -1;
+
+	}
+
+	Agent agent;
+	agent.cell = cell;
+	agent.goal = goal;
+	agent.state = AGENT_WAITING_FOR_PATH;
+	agent.pathPosition = 0;
+	agent.blockedTicks = 0;
+	agent.target = -1;
+
+	occupants[cell] = (int)agents.size();
+	agents.push_back(agent);
+
+	return occupants[cell];
+
+}
+
+// Give an agent a new goal
+void AgentSimulation::SetGoal(int agent, int goal)
+{
+
+	agents[agent].goal = goal;
+	agents[agent].state = AGENT_WAITING_FOR_PATH;
+	agents[agent].path.clear();
+	agents[agent].pathPosition = 0;
+	agents[agent].blockedTicks = 0;
+
+}
+
+// Remove every agent
+void AgentSimulation::Clear()
+{
+
+	for (const Agent& agent : agents)
+	{
+
+		occupants[agent.cell] = -1;
+
+	}
+
+	agents.clear();
+
+}
+
+// Move the simulation forward a tick
+void AgentSimulation::Tick()
+{
+
+	std::chrono::steady_clock::time_point pathStartTime = std::chrono::steady_clock::now();
+
+	// Gather every path request into one batch, so they're all solved in parallel
+	queries.clear();
+	queryAgents.clear();
+
+	for (int i = 0; i < (int)agents.size(); i++)
+	{
+
+		if (agents[i].state == AGENT_WAITING_FOR_PATH)
+		{
+
+			PathQuery query;
+			query.start = agents[i].cell;
+			query.end = agents[i].goal;
+
+			queries.push_back(query);
+			queryAgents.push_back(i);
+
+		}
+
+	}
+
+	if (!queries.empty())
+	{
+
+		int hitCount = cache.GetHitCount();
+
+		pathfinder.FindPaths(queries, &results);
+
+		stats.pathRequests += queries.size();
+		stats.cacheHits += cache.GetHitCount() - hitCount;
+
+		for (size_t i = 0; i < queries.size(); i++)
+		{
+
+			Agent& agent = agents[queryAgents[i]];
+
+			agent.path.swap(results[i].path);
+			agent.pathPosition = 0;
+			agent.blockedTicks = 0;
+
+			if (!results[i].found)
+			{
+
+				agent.state = AGENT_UNREACHABLE;
+
+			}
+			else
+			{
+
+				agent.state = agent.cell == agent.goal ? AGENT_ARRIVED : AGENT_MOVING;
+
+			}
+
+		}
+
+	}
+
+	std::chrono::steady_clock::time_point moveStartTime = std::chrono::steady_clock::now();
+
+	// Every agent claims its next cell before any agent moves, so claims only see where agents were at the start of the tick
+	ForEachAgent([this](int agent) { ChooseTarget(agent); });
+	ForEachAgent([this](int agent) { Move(agent); });
+
+	// Release the claims and count up what happened
+	for (Agent& agent : agents)
+	{
+
+		if (agent.target == -1)
+		{
+
+			continue;
+
+		}
+
+		claims[agent.target].store(INT_MAX, std::memory_order_relaxed);
+
+		if (agent.cell != agent.target)
+		{
+
+			stats.blocks++;
+
+		}
+		else
+		{
+
+			stats.moves++;
+
+			if (agent.state == AGENT_ARRIVED)
+			{
+
+				stats.arrivals++;
+
+			}
+
+		}
+
+	}
+
+	std::chrono::steady_clock::time_point endTime = std::chrono::steady_clock::now();
+
+	stats.pathNanoseconds += std::chrono::duration_cast<std::chrono::nanoseconds>(moveStartTime - pathStartTime).count();
+	stats.moveNanoseconds += std::chrono::duration_cast<std::chrono::nanoseconds>(endTime - moveStartTime).count();
+	stats.ticks++;
+
+}
+
+// Let the simulation know a cell's obstacle state has changed
+void AgentSimulation::UpdateCell(int index)
+{
+
+	pathfinder.UpdateCell(index);
+
+	if (useCache)
+	{
+
+		cache.UpdateCell(index);
+
+	}
+
+	if (grid->IsObstacle(index))
+	{
+
+		return;
+
+	}
+
+	// A cleared cell might open up a route for agents that couldn't reach their goals
+	for (Agent& agent : agents)
+	{
+
+		if (agent.state == AGENT_UNREACHABLE)
+		{
+
+			agent.state = AGENT_WAITING_FOR_PATH;
+
+		}
+
+	}
+
+}
+
+// Let the simulation know many cells have changed at once
+void AgentSimulation::UpdateAllCells()
+{
+
+	cache.Clear();
+
+	for (Agent& agent : agents)
+	{
+
+		if (agent.state == AGENT_UNREACHABLE)
+		{
+
+			agent.state = AGENT_WAITING_FOR_PATH;
+
+		}
+
+	}
+
+}
+
+// Pick the cell an agent will try to move to this tick and claim it
+// Only the agent's own state is written, and the claims are raised atomically, so this is safe to run for every agent at once
+void AgentSimulation::ChooseTarget(int agent)
+{
+
+	Agent& current = agents[agent];
+	current.target = -1;
+
+	if (current.state != AGENT_MOVING)
+	{
+
+		return;
+
+	}
+
+	int next = current.path[current.pathPosition + 1];
+
+	// The path has run into an obstacle added since it was found
+	if (grid->IsObstacle(next))
+	{
+
+		current.state = AGENT_WAITING_FOR_PATH;
+
+		return;
+
+	}
+
+	if (current.blockedTicks >= patience)
+	{
+
+		int sidestep = FindSidestep(agent, next);
+
+		if (sidestep != -1)
+		{
+
+			next = sidestep;
+
+		}
+
+	}
+
+	current.target = next;
+
+	// Nobody can claim a cell that's occupied, so an agent never moves into a cell another agent is still standing in
+	if (occupants[next] != -1)
+	{
+
+		return;
+
+	}
+
+	// Lower the claim to this agent's number unless a lower numbered agent already has it
+	int claim = claims[next].load(std::memory_order_relaxed);
+
+	while (agent < claim && !claims[next].compare_exchange_weak(claim, agent, std::memory_order_relaxed))
+	{
+
+	}
+
+}
+
+// Find the empty neighbour of an agent's cell closest to its goal, other than the cell it's blocked by
+int AgentSimulation::FindSidestep(int agent, int blockedCell)
+{
+
+	const Agent& current = agents[agent];
+	int x = grid->GetX(current.cell);
+	int y = grid->GetY(current.cell);
+	int goalX = grid->GetX(current.goal);
+	int goalY = grid->GetY(current.goal);
+	unsigned int passable = grid->GetNeighbourMask(x, y);
+	int bestCell = -1;
+	int bestDistance = INT_MAX;
+
+	for (int direction = 0; direction < DIRECTION_COUNT; direction++)
+	{
+
+		int neighbour = current.cell + grid->GetNeighbourOffset(direction);
+
+		if ((passable & (1u << direction)) == 0 || neighbour == blockedCell || occupants[neighbour] != -1)
+		{
+
+			continue;
+
+		}
+
+		int distance = EstimateDistance(HEURISTIC_OCTILE, goalX - (x + DIRECTIONS[direction].x), goalY - (y + DIRECTIONS[direction].y));
+
+		if (distance < bestDistance)
+		{
+
+			bestCell = neighbour;
+			bestDistance = distance;
+
+		}
+
+	}
+
+	return bestCell;
+
+}
+
+// Move an agent to its target if it won the claim on it
+// Each claimed cell has one winner and was empty at the start of the tick, so no two agents write the same occupant entry
+void AgentSimulation::Move(int agent)
+{
+
+	Agent& current = agents[agent];
+
+	if (current.target == -1)
+	{
+
+		return;
+
+	}
+
+	if (claims[current.target].load(std::memory_order_relaxed) != agent)
+	{
+
+		current.blockedTicks++;
+
+		return;
+
+	}
+
+	bool isOnPath = current.target == current.path[current.pathPosition + 1];
+
+	occupants[current.cell] = -1;
+	occupants[current.target] = agent;
+	current.cell = current.target;
+	current.blockedTicks = 0;
+
+	if (!isOnPath)
+	{
+
+		// Stepped aside, so the rest of the path no longer starts from here
+		current.state = AGENT_WAITING_FOR_PATH;
+
+	}
+	else if (++current.pathPosition == (int)current.path.size() - 1)
+	{
+
+		current.state = AGENT_ARRIVED;
+
+	}
+
+}
+
+// Run a function over every agent, spread across the worker threads
+template <typename Function> void AgentSimulation::ForEachAgent(Function function)
+{
+
+	ThreadPool* pool = pathfinder.GetThreadPool();
+	int agentCount = (int)agents.size();
+
+	for (int first = 0; first < agentCount; first += AGENTS_PER_TASK)
+	{
+
+		int last = std::min(first + AGENTS_PER_TASK, agentCount);
+
+		pool->Submit([function, first, last](int)
+		{
+
+			for (int i = first; i < last; i++)
+			{
+
+				function(i);
+
+			}
+
+		});
+
+	}
+
+	pool->Wait();
+
+}
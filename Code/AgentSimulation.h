@@ -0,0 +1,133 @@
+// AgentSimulation class - moves many agents across a grid towards their goals, one step per tick
+// Agents that need a path request one from a BatchPathfinder at the start of each tick, so every request in a tick is solved as one parallel batch
+// Agents are then moved in parallel in two passes: each agent claims the next cell on its path, and the lowest numbered agent claiming a cell wins it
+// Claims are only made on cells that were empty at the start of the tick, so the outcome doesn't depend on thread count or timing
+// An agent whose path runs into a new obstacle requests a new path; one held up by other agents for too long steps aside and requests a new path from there
+// Has no dependency on SFML, so it can be run headless to measure ticks per second
+
+#ifndef _AGENTSIMULATION_H_
+#define _AGENTSIMULATION_H_
+
+#include <atomic>
+#include <vector>
+#include "Grid.h"
+#include "BatchPathfinder.h"
+#include "PathCache.h"
+
+// What an agent is doing
+enum AgentState
+{
+	// Waiting for a path to its goal, which it will request at the start of the next tick
+	AGENT_WAITING_FOR_PATH,
+	// Following its path
+	AGENT_MOVING,
+	// Standing on its goal
+	AGENT_ARRIVED,
+	// Its goal can't be reached; it will try again once an obstacle is cleared or it's given a new goal
+	AGENT_UNREACHABLE
+};
+
+// A single agent
+struct Agent
+{
+	int cell;
+	int goal;
+	AgentState state;
+	// Path from the cell the agent was in when it was found to the goal, and the position of the agent's current cell along it
+	std::vector<int> path;
+	int pathPosition;
+	// Ticks in a row the agent has been unable to move because of other agents
+	int blockedTicks;
+	// Cell the agent is trying to move to this tick, -1 if it isn't moving
+	int target;
+};
+
+// Totals for everything that has happened since the simulation was created
+struct SimulationStats
+{
+	int ticks;
+	// Steps taken by agents
+	long long moves;
+	// Ticks agents spent unable to move because another agent was in the way
+	long long blocks;
+	// Paths requested, and how many of those were answered from the cache
+	long long pathRequests;
+	long long cacheHits;
+	// Times an agent reached its goal
+	long long arrivals;
+	// Time spent finding paths and moving agents, in nanoseconds
+	long long pathNanoseconds;
+	long long moveNanoseconds;
+};
+
+class AgentSimulation
+{
+
+public:
+
+	// Constructor - pass in the grid, the number of worker threads (0 for one per hardware thread) and the most paths to cache (0 to always search)
+	AgentSimulation(Grid* grid, int threadCount, int cacheCapacity);
+	~AgentSimulation();
+
+	int GetThreadCount() { return pathfinder.GetThreadCount(); }
+	// Set the search mode used for path requests
+	void SetSearchMode(SearchMode mode) { pathfinder.SetSearchMode(mode); }
+	// Set how many ticks in a row an agent waits behind other agents before stepping aside and finding a new path
+	void SetPatience(int ticks) { patience = ticks; }
+
+	// Add an agent on a passable, empty cell, returning its number, or -1 if the cell can't be used
+	int AddAgent(int cell, int goal);
+	// Give an agent a new goal; it will request a path to it on the next tick
+	void SetGoal(int agent, int goal);
+	// Remove every agent
+	void Clear();
+
+	// Move the simulation forward a tick: find the paths agents have asked for, then move every agent that can move a step
+	void Tick();
+
+	// Let the simulation know a cell's obstacle state has changed
+	// Agents whose paths cross a new obstacle find out when they reach it; agents without a path try again if an obstacle is cleared
+	void UpdateCell(int index);
+	// Let the simulation know many cells have changed at once, emptying the cache and letting agents without a path try again
+	void UpdateAllCells();
+
+	int GetAgentCount() { return (int)agents.size(); }
+	const Agent& GetAgent(int agent) { return agents[agent]; }
+	// Get the agent standing on a cell, -1 if it's empty
+	int GetAgentAt(int cell) { return occupants[cell]; }
+	const SimulationStats& GetStats() { return stats; }
+
+private:
+
+	// Pick the cell an agent will try to move to this tick and claim it
+	void ChooseTarget(int agent);
+	// Find the empty neighbour of an agent's cell closest to its goal, other than the cell it's blocked by, -1 if there isn't one
+	int FindSidestep(int agent, int blockedCell);
+	// Move an agent to its target if it won the claim on it
+	void Move(int agent);
+	// Run a function over every agent, spread across the worker threads
+	template <typename Function> void ForEachAgent(Function function);
+
+	Grid* grid;
+
+	BatchPathfinder pathfinder;
+	PathCache cache;
+	bool useCache;
+
+	std::vector<Agent> agents;
+	// Agent standing on each cell, -1 for empty cells
+	std::vector<int> occupants;
+	// Lowest numbered agent claiming each cell this tick, INT_MAX for unclaimed cells
+	std::vector<std::atomic<int> > claims;
+
+	// Queries for the agents that need paths this tick, and the agent each query is for
+	std::vector<PathQuery> queries;
+	std::vector<PathResult> results;
+	std::vector<int> queryAgents;
+
+	int patience;
+	SimulationStats stats;
+
+};
+
+#endif
@@ -0,0 +1,195 @@
+// BatchPathfinder.cpp
+
+#include "BatchPathfinder.h"
+#include <algorithm>
+
+// Number of queries handed to a worker at a time; large enough to keep task overhead low, small enough for stealing to balance the load
+const int QUERIES_PER_TASK = 16;
+
+BatchPathfinder::BatchPathfinder(Grid* grid, int threadCount) : pool(threadCount)
+{
+
+	this->grid = grid;
+
+	mode = SEARCH_MODE_ASTAR;
+	heuristic = HEURISTIC_OCTILE;
+	heuristicWeight = 2.0;
+	cache = NULL;
+
+	for (int i = 0; i < pool.GetThreadCount(); i++)
+	{
+
+		pathfinders.push_back(new Pathfinder(grid));
+		pathfinders.back()->SetJumpPointTable(&jumpPoints);
+		pathfinders.back()->SetComponents(&components);
+
+	}
+
+}
+
+BatchPathfinder::~BatchPathfinder()
+{
+
+	for (Pathfinder* pathfinder : pathfinders)
+	{
+
+		delete pathfinder;
+
+	}
+
+	pathfinders.clear();
+
+	grid = NULL;
+
+}
+
+// Set the search mode used by every worker
+void BatchPathfinder::SetSearchMode(SearchMode mode)
+{
+
+	this->mode = mode;
+
+	for (Pathfinder* pathfinder : pathfinders)
+	{
+
+		pathfinder->SetSearchMode(mode);
+
+	}
+
+}
+
+// Set the heuristic used by every worker
+void BatchPathfinder::SetHeuristic(HeuristicType heuristic)
+{
+
+	this->heuristic = heuristic;
+
+	for (Pathfinder* pathfinder : pathfinders)
+	{
+
+		pathfinder->SetHeuristic(heuristic);
+
+	}
+
+}
+
+// Set the heuristic weight used by every worker
+void BatchPathfinder::SetHeuristicWeight(double weight)
+{
+
+	heuristicWeight = weight;
+
+	for (Pathfinder* pathfinder : pathfinders)
+	{
+
+		pathfinder->SetHeuristicWeight(weight);
+
+	}
+
+}
+
+// Solve a batch of queries across the worker threads
+void BatchPathfinder::FindPaths(const PathQuery* queries, int queryCount, PathResult* results)
+{
+
+	// The shared table has to be up to date before any worker reads it
+	if (mode == SEARCH_MODE_JPS_PLUS && !jumpPoints.IsBuiltFor(grid))
+	{
+
+		jumpPoints.Build(grid);
+
+	}
+
+	// Edits passed to UpdateCell usually keep the labels current, so relabelling the whole grid is only needed when they couldn't
+	if (!components.IsBuiltFor(grid))
+	{
+
+		components.Build(grid);
+
+	}
+
+	// Answer what the cache can before starting any workers, so only the queries it couldn't answer are searched
+	// Results found with other settings could be longer or shorter than these settings find, so they're dropped first
+	if (cache != NULL)
+	{
+
+		cache->SetSearchSettings(mode, heuristic, heuristicWeight);
+
+	}
+
+	misses.clear();
+
+	for (int i = 0; i < queryCount; i++)
+	{
+
+		if (cache != NULL && cache->Lookup(queries[i].start, queries[i].end, &results[i].path, &results[i].cost))
+		{
+
+			results[i].found = results[i].cost != -1;
+
+		}
+		else
+		{
+
+			misses.push_back(i);
+
+		}
+
+	}
+
+	int missCount = (int)misses.size();
+
+	for (int first = 0; first < missCount; first += QUERIES_PER_TASK)
+	{
+
+		int last = std::min(first + QUERIES_PER_TASK, missCount);
+
+		pool.Submit([this, queries, results, first, last](int worker)
+		{
+
+			Pathfinder* pathfinder = pathfinders[worker];
+
+			for (int j = first; j < last; j++)
+			{
+
+				int i = misses[j];
+
+				results[i].found = pathfinder->FindPath(queries[i].start, queries[i].end, &results[i].path);
+				results[i].cost = pathfinder->GetPathCost();
+
+			}
+
+		});
+
+	}
+
+	pool.Wait();
+
+	if (cache != NULL)
+	{
+
+		for (int i : misses)
+		{
+
+			cache->Store(queries[i].start, queries[i].end, results[i].path, results[i].cost);
+
+		}
+
+	}
+
+}
+
+// Solve a batch of queries across the worker threads, resizing the results to match
+void BatchPathfinder::FindPaths(const std::vector<PathQuery>& queries, std::vector<PathResult>* results)
+{
+
+	results->resize(queries.size());
+
+	if (!queries.empty())
+	{
+
+		FindPaths(&queries[0], (int)queries.size(), &(*results)[0]);
+
+	}
+
+}
@@ -0,0 +1,81 @@
+// BatchPathfinder class - solves many path queries against the same grid in parallel
+// Each worker thread has its own Pathfinder for search state, while the grid (and JPS+ table and region labels) is shared read-only between them
+
+#ifndef _BATCHPATHFINDER_H_
+#define _BATCHPATHFINDER_H_
+
+#include <vector>
+#include "Grid.h"
+#include "Pathfinder.h"
+#include "ThreadPool.h"
+#include "PathCache.h"
+
+// A single start/end pair to find a path between
+struct PathQuery
+{
+	int start;
+	int end;
+};
+
+// The outcome of a single query
+struct PathResult
+{
+	bool found;
+	// Cost of the path, -1 if none was found
+	int cost;
+	// Cells along the path from start to end, empty if none was found
+	std::vector<int> path;
+};
+
+class BatchPathfinder
+{
+
+public:
+
+	// Constructor - pass in the grid to search over and the number of worker threads, or 0 to use one per hardware thread
+	BatchPathfinder(Grid* grid, int threadCount);
+	~BatchPathfinder();
+
+	int GetThreadCount() { return pool.GetThreadCount(); }
+	// Get the worker threads, so other per-tick work can be run on them between batches
+	ThreadPool* GetThreadPool() { return &pool; }
+
+	// Settings applied to every worker's pathfinder
+	void SetSearchMode(SearchMode mode);
+	void SetHeuristic(HeuristicType heuristic);
+	void SetHeuristicWeight(double weight);
+	// Answer repeated queries from a cache, storing the results of new ones in it, or NULL to always search
+	// The cache is only used between batches, never by the workers; whoever owns it must tell it about obstacle edits
+	void SetPathCache(PathCache* cache) { this->cache = cache; }
+
+	// Update the shared region labels after a single cell's obstacle state has changed
+	// Labels that miss an edit, or that an edit might have split, are rebuilt from scratch before the next batch
+	void UpdateCell(int index) { components.UpdateCell(index); }
+
+	// Solve a batch of queries, writing the result of queries[i] to results[i]
+	// The grid must not be edited until this returns
+	void FindPaths(const PathQuery* queries, int queryCount, PathResult* results);
+	void FindPaths(const std::vector<PathQuery>& queries, std::vector<PathResult>* results);
+
+private:
+
+	Grid* grid;
+
+	ThreadPool pool;
+	// One pathfinder per worker, indexed by worker
+	std::vector<Pathfinder*> pathfinders;
+	// Optional cache of earlier results, and the queries in the current batch it couldn't answer
+	PathCache* cache;
+	std::vector<int> misses;
+	// JPS+ table shared by every worker, rebuilt before a batch if the grid has changed
+	JumpPointTable jumpPoints;
+	// Region labels shared by every worker, kept current by UpdateCell and only rebuilt before a batch if that couldn't be done in place
+	ConnectedComponents components;
+
+	SearchMode mode;
+	HeuristicType heuristic;
+	double heuristicWeight;
+
+};
+
+#endif
@@ -0,0 +1,619 @@
+// Benchmark.cpp
+// Headless benchmark - runs every query in a scenario through each search mode and reports expansions, path costs and latencies
+// Build it from every source file except Main.cpp and GridRenderer.cpp, so it doesn't need SFML
+// Usage: Benchmark <map file> [scenario file] [-n random query count] [-s random seed] [-o stats file] [-w heuristic weight]
+//        Benchmark <map file> -a agent count [-k ticks] [-j threads] [-c cache capacity] [-s random seed]
+// Without a scenario file, random queries are made between passable cells (useful for grids saved from the demo)
+// With a stats file, every query's search stats are written out for each mode, as JSON if the file name ends in .json or CSV otherwise
+// With an agent count, the map is filled with agents heading for random goals instead, and the agent simulation's ticks per second are reported
+
+#include <algorithm>
+#include <chrono>
+#include <fstream>
+#include <math.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <vector>
+#include "AgentSimulation.h"
+#include "ConnectedComponents.h"
+#include "Grid.h"
+#include "Pathfinder.h"
+#include "JumpPointTable.h"
+#include "MapFile.h"
+#include "SearchStats.h"
+
+// A single query to benchmark
+struct BenchmarkQuery
+{
+	int start;
+	int end;
+	// Optimal path length given by the scenario file, -1 for random queries
+	double optimalLength;
+};
+
+// Find the length of a path, counting straight moves as 1 and diagonal moves as the square root of 2 (as scenario files do)
+static double GetPathLength(Grid* grid, const std::vector<int>& path)
+{
+
+	double length = 0.0;
+
+	for (size_t i = 1; i < path.size(); i++)
+	{
+
+		bool isDiagonal = grid->GetX(path[i]) != grid->GetX(path[i - 1]) && grid->GetY(path[i]) != grid->GetY(path[i - 1]);
+
+		length += isDiagonal ? sqrt(2.0) : 1.0;
+
+	}
+
+	return length;
+
+}
+
+// Get a percentile from a sorted list of values
+static double GetPercentile(const std::vector<double>& sorted, double fraction)
+{
+
+	if (sorted.empty())
+	{
+
+		return 0.0;
+
+	}
+
+	size_t index = (size_t)(fraction * (sorted.size() - 1) + 0.5);
+
+	return sorted[index];
+
+}
+
+// Run every query through one search mode and print a row of results
+// The A* costs are used as the reference; every search mode should match them except weighted A*, which should stay within its bound of them
+// Returns the number of queries that didn't
+// Each query's search stats are added to queryStats, if it isn't NULL
+static int RunMode(Grid* grid, Pathfinder* pathfinder, SearchMode mode, const std::vector<BenchmarkQuery>& queries, std::vector<int>* referenceCosts,
+	std::vector<SearchStats>* queryStats)
+{
+
+	pathfinder->SetSearchMode(mode);
+
+	std::vector<int> path;
+	std::vector<double> latencies;
+	long long totalExpanded = 0;
+	long long totalCost = 0;
+	double totalScenarioRatio = 0.0;
+	int scenarioCount = 0;
+	int foundCount = 0;
+	int mismatchCount = 0;
+
+	for (size_t i = 0; i < queries.size(); i++)
+	{
+
+		std::chrono::steady_clock::time_point startTime = std::chrono::steady_clock::now();
+
+		bool isFound = pathfinder->FindPath(queries[i].start, queries[i].end, &path);
+
+		std::chrono::steady_clock::time_point endTime = std::chrono::steady_clock::now();
+
+		latencies.push_back(std::chrono::duration<double, std::micro>(endTime - startTime).count());
+		totalExpanded += pathfinder->GetExpansionCount();
+
+		if (queryStats != NULL)
+		{
+
+			queryStats->push_back(pathfinder->GetStats());
+
+		}
+
+		int cost = pathfinder->GetPathCost();
+
+		if (mode == SEARCH_MODE_ASTAR)
+		{
+
+			(*referenceCosts)[i] = cost;
+
+		}
+		else if (mode == SEARCH_MODE_WEIGHTED_ASTAR)
+		{
+
+			int referenceCost = (*referenceCosts)[i];
+
+			if ((cost == -1) != (referenceCost == -1) || (cost != -1 && cost > referenceCost * pathfinder->GetHeuristicWeight()))
+			{
+
+				mismatchCount++;
+
+			}
+
+		}
+		else if (cost != (*referenceCosts)[i])
+		{
+
+			mismatchCount++;
+
+		}
+
+		if (!isFound)
+		{
+
+			continue;
+
+		}
+
+		foundCount++;
+		totalCost += cost;
+
+		if (queries[i].optimalLength > 0.0)
+		{
+
+			totalScenarioRatio += GetPathLength(grid, path) / queries[i].optimalLength;
+			scenarioCount++;
+
+		}
+
+	}
+
+	std::sort(latencies.begin(), latencies.end());
+
+	int queryCount = std::max((int)queries.size(), 1);
+
+	// The found count and scenario ratio are formatted first, so every column uses the same widths as the header
+	// Queries without a scenario length (random queries, or scenario entries with a length of 0) have no ratio to show
+	char found[32];
+	snprintf(found, sizeof(found), "%d/%d", foundCount, (int)queries.size());
+
+	char scenarioRatio[32] = "-";
+
+	if (scenarioCount > 0)
+	{
+
+		snprintf(scenarioRatio, sizeof(scenarioRatio), "%.4f", totalScenarioRatio / scenarioCount);
+
+	}
+
+	printf("%-18s %15s %10.1f %10.1f %9s %9.1f %9.1f %9.1f %9.1f %8d\n",
+		GetSearchModeName(mode),
+		found,
+		(double)totalExpanded / queryCount,
+		foundCount > 0 ? (double)totalCost / foundCount : 0.0,
+		scenarioRatio,
+		GetPercentile(latencies, 0.5), GetPercentile(latencies, 0.9), GetPercentile(latencies, 0.99),
+		latencies.empty() ? 0.0 : latencies.back(),
+		mismatchCount);
+
+	return mismatchCount;
+
+}
+
+// Write every query's search stats for each mode, one row or object per query labelled with the mode
+// JSON files hold an array of objects and anything else is written as CSV; returns false if the file couldn't be written
+static bool WriteStats(const char* filename, const std::vector<std::vector<SearchStats> >& modeStats)
+{
+
+	std::ofstream file(filename);
+
+	if (!file)
+	{
+
+		return false;
+
+	}
+
+	size_t length = strlen(filename);
+	bool isJson = length >= 5 && strcmp(filename + length - 5, ".json") == 0;
+	bool isFirst = true;
+
+	if (isJson)
+	{
+
+		file << "[\n";
+
+	}
+	else
+	{
+
+		WriteSearchStatsCsvHeader(file);
+
+	}
+
+	for (int mode = 0; mode < (int)modeStats.size(); mode++)
+	{
+
+		for (const SearchStats& stats : modeStats[mode])
+		{
+
+			if (isJson)
+			{
+
+				file << (isFirst ? "  " : ",\n  ");
+				WriteSearchStatsJson(file, GetSearchModeName((SearchMode)mode), stats);
+
+			}
+			else
+			{
+
+				WriteSearchStatsCsv(file, GetSearchModeName((SearchMode)mode), stats);
+
+			}
+
+			isFirst = false;
+
+		}
+
+	}
+
+	if (isJson)
+	{
+
+		file << "\n]\n";
+
+	}
+
+	return (bool)file;
+
+}
+
+// Run the agent simulation for a number of ticks, giving each agent a new random goal whenever it arrives, and print how fast it ran
+static void RunAgents(Grid* grid, int agentCount, int tickCount, int threadCount, int cacheCapacity, unsigned int seed)
+{
+
+	std::vector<int> passableCells;
+
+	for (int i = 0; i < grid->GetCellCount(); i++)
+	{
+
+		if (!grid->IsObstacle(i))
+		{
+
+			passableCells.push_back(i);
+
+		}
+
+	}
+
+	// Agents need a cell each, with some room left for them to move around
+	agentCount = std::min(agentCount, (int)passableCells.size() / 2);
+
+	AgentSimulation simulation(grid, threadCount, cacheCapacity);
+	simulation.SetSearchMode(SEARCH_MODE_JPS_PLUS);
+
+	srand(seed);
+
+	while (simulation.GetAgentCount() < agentCount)
+	{
+
+		simulation.AddAgent(passableCells[rand() % passableCells.size()], passableCells[rand() % passableCells.size()]);
+
+	}
+
+	printf("%d agents, %d worker threads, %s paths, cache capacity %d\n\n", agentCount, simulation.GetThreadCount(),
+		GetSearchModeName(SEARCH_MODE_JPS_PLUS), cacheCapacity);
+
+	std::vector<double> tickTimes;
+
+	for (int tick = 0; tick < tickCount; tick++)
+	{
+
+		std::chrono::steady_clock::time_point startTime = std::chrono::steady_clock::now();
+
+		simulation.Tick();
+
+		std::chrono::steady_clock::time_point endTime = std::chrono::steady_clock::now();
+
+		tickTimes.push_back(std::chrono::duration<double, std::milli>(endTime - startTime).count());
+
+		for (int i = 0; i < simulation.GetAgentCount(); i++)
+		{
+
+			if (simulation.GetAgent(i).state == AGENT_ARRIVED)
+			{
+
+				simulation.SetGoal(i, passableCells[rand() % passableCells.size()]);
+
+			}
+
+		}
+
+	}
+
+	const SimulationStats& stats = simulation.GetStats();
+	double totalTime = 0.0;
+
+	for (double time : tickTimes)
+	{
+
+		totalTime += time;
+
+	}
+
+	std::sort(tickTimes.begin(), tickTimes.end());
+
+	int ticks = std::max(stats.ticks, 1);
+
+	printf("Ticks per second   %10.1f\n", totalTime > 0.0 ? stats.ticks * 1000.0 / totalTime : 0.0);
+	printf("Tick ms            %10.3f mean, %.3f p50, %.3f p99, %.3f max\n", totalTime / ticks,
+		GetPercentile(tickTimes, 0.5), GetPercentile(tickTimes, 0.99), tickTimes.empty() ? 0.0 : tickTimes.back());
+	printf("Pathfinding ms     %10.3f per tick\n", stats.pathNanoseconds / 1000000.0 / ticks);
+	printf("Movement ms        %10.3f per tick\n", stats.moveNanoseconds / 1000000.0 / ticks);
+	printf("Moves              %10.1f per tick\n", (double)stats.moves / ticks);
+	printf("Blocked            %10.1f per tick\n", (double)stats.blocks / ticks);
+	printf("Path requests      %10.1f per tick (%.1f%% from the cache)\n", (double)stats.pathRequests / ticks,
+		stats.pathRequests > 0 ? 100.0 * stats.cacheHits / stats.pathRequests : 0.0);
+	printf("Arrivals           %10lld\n", stats.arrivals);
+
+}
+
+int main(int argc, char** argv)
+{
+
+	const char* mapFilename = NULL;
+	const char* scenarioFilename = NULL;
+	const char* statsFilename = NULL;
+	int randomQueryCount = 1000;
+	unsigned int seed = 1;
+	int agentCount = 0;
+	int tickCount = 1000;
+	int threadCount = 0;
+	int cacheCapacity = 0;
+	double heuristicWeight = 2.0;
+
+	for (int i = 1; i < argc; i++)
+	{
+
+		if (strcmp(argv[i], "-n") == 0 && i + 1 < argc)
+		{
+
+			randomQueryCount = atoi(argv[++i]);
+
+		}
+		else if (strcmp(argv[i], "-s") == 0 && i + 1 < argc)
+		{
+
+			seed = (unsigned int)atoi(argv[++i]);
+
+		}
+		else if (strcmp(argv[i], "-o") == 0 && i + 1 < argc)
+		{
+
+			statsFilename = argv[++i];
+
+		}
+		else if (strcmp(argv[i], "-w") == 0 && i + 1 < argc)
+		{
+
+			heuristicWeight = atof(argv[++i]);
+
+		}
+		else if (strcmp(argv[i], "-a") == 0 && i + 1 < argc)
+		{
+
+			agentCount = atoi(argv[++i]);
+
+		}
+		else if (strcmp(argv[i], "-k") == 0 && i + 1 < argc)
+		{
+
+			tickCount = atoi(argv[++i]);
+
+		}
+		else if (strcmp(argv[i], "-j") == 0 && i + 1 < argc)
+		{
+
+			threadCount = atoi(argv[++i]);
+
+		}
+		else if (strcmp(argv[i], "-c") == 0 && i + 1 < argc)
+		{
+
+			cacheCapacity = atoi(argv[++i]);
+
+		}
+		else if (mapFilename == NULL)
+		{
+
+			mapFilename = argv[i];
+
+		}
+		else if (scenarioFilename == NULL)
+		{
+
+			scenarioFilename = argv[i];
+
+		}
+
+	}
+
+	if (mapFilename == NULL)
+	{
+
+		fprintf(stderr, "Usage: %s <map file> [scenario file] [-n random query count] [-s random seed] [-o stats file] [-w heuristic weight]\n", argv[0]);
+		fprintf(stderr, "       %s <map file> -a agent count [-k ticks] [-j threads] [-c cache capacity] [-s random seed]\n", argv[0]);
+		return 1;
+
+	}
+
+	Grid* grid = LoadMap(mapFilename);
+
+	if (grid == NULL)
+	{
+
+		fprintf(stderr, "Couldn't load map file %s\n", mapFilename);
+		return 1;
+
+	}
+
+	if (agentCount > 0)
+	{
+
+		printf("Map %s: %dx%d, ", mapFilename, grid->GetWidth(), grid->GetHeight());
+
+		RunAgents(grid, agentCount, tickCount, threadCount, cacheCapacity, seed);
+
+		delete grid;
+		return 0;
+
+	}
+
+	std::vector<BenchmarkQuery> queries;
+	int skippedCount = 0;
+
+	if (scenarioFilename != NULL)
+	{
+
+		std::vector<ScenarioQuery> scenario;
+
+		if (!LoadScenario(scenarioFilename, &scenario))
+		{
+
+			fprintf(stderr, "Couldn't load scenario file %s\n", scenarioFilename);
+			delete grid;
+			return 1;
+
+		}
+
+		for (const ScenarioQuery& scenarioQuery : scenario)
+		{
+
+			// Skip queries that don't fit this map, such as ones written for a scaled version of it
+			if (!grid->IsPassable(scenarioQuery.startX, scenarioQuery.startY) || !grid->IsPassable(scenarioQuery.endX, scenarioQuery.endY))
+			{
+
+				skippedCount++;
+				continue;
+
+			}
+
+			BenchmarkQuery query;
+			query.start = grid->GetIndex(scenarioQuery.startX, scenarioQuery.startY);
+			query.end = grid->GetIndex(scenarioQuery.endX, scenarioQuery.endY);
+			query.optimalLength = scenarioQuery.optimalLength;
+
+			queries.push_back(query);
+
+		}
+
+	}
+	else
+	{
+
+		std::vector<int> passableCells;
+
+		for (int i = 0; i < grid->GetCellCount(); i++)
+		{
+
+			if (!grid->IsObstacle(i))
+			{
+
+				passableCells.push_back(i);
+
+			}
+
+		}
+
+		srand(seed);
+
+		for (int i = 0; i < randomQueryCount && !passableCells.empty(); i++)
+		{
+
+			BenchmarkQuery query;
+			query.start = passableCells[rand() % passableCells.size()];
+			query.end = passableCells[rand() % passableCells.size()];
+			query.optimalLength = -1.0;
+
+			queries.push_back(query);
+
+		}
+
+	}
+
+	printf("Map %s: %dx%d, %d queries", mapFilename, grid->GetWidth(), grid->GetHeight(), (int)queries.size());
+
+	if (skippedCount > 0)
+	{
+
+		printf(" (%d skipped)", skippedCount);
+
+	}
+
+	printf("\n");
+
+	Pathfinder pathfinder(grid);
+	pathfinder.SetHeuristicWeight(heuristicWeight);
+
+	// Build the JPS+ table up front, so the preprocessing time is reported separately from the query latencies
+	JumpPointTable jumpPoints;
+
+	std::chrono::steady_clock::time_point buildStartTime = std::chrono::steady_clock::now();
+
+	bool isJumpTableBuilt = jumpPoints.Build(grid);
+
+	std::chrono::steady_clock::time_point buildEndTime = std::chrono::steady_clock::now();
+
+	pathfinder.SetJumpPointTable(&jumpPoints);
+
+	if (isJumpTableBuilt)
+	{
+
+		printf("JPS+ table built in %.1f ms\n", std::chrono::duration<double, std::milli>(buildEndTime - buildStartTime).count());
+
+	}
+	else
+	{
+
+		printf("Map too large for a JPS+ table, JPS+ runs as JPS\n");
+
+	}
+
+	// Likewise the region labels used to reject unreachable queries
+	ConnectedComponents components;
+
+	buildStartTime = std::chrono::steady_clock::now();
+
+	components.Build(grid);
+
+	buildEndTime = std::chrono::steady_clock::now();
+
+	pathfinder.SetComponents(&components);
+
+	printf("Region labels built in %.1f ms\n\n", std::chrono::duration<double, std::milli>(buildEndTime - buildStartTime).count());
+
+	// Costs use the integer step costs (10 and 14); the scenario ratio compares path lengths against the scenario's optimal lengths
+	// The scenario ratio can fall below 1, as scenario files don't let diagonal moves cut past obstacle corners and this pathfinder does
+	printf("%-18s %15s %10s %10s %9s %9s %9s %9s %9s %8s\n",
+		"Mode", "Found", "Expanded", "Cost", "Scenario", "p50 us", "p90 us", "p99 us", "Max us", "Mismatch");
+
+	std::vector<int> referenceCosts(queries.size(), -1);
+	std::vector<std::vector<SearchStats> > modeStats(SEARCH_MODE_COUNT);
+	int mismatchCount = 0;
+
+	for (int mode = 0; mode < SEARCH_MODE_COUNT; mode++)
+	{
+
+		mismatchCount += RunMode(grid, &pathfinder, (SearchMode)mode, queries, &referenceCosts, statsFilename != NULL ? &modeStats[mode] : NULL);
+
+	}
+
+	delete grid;
+
+	if (statsFilename != NULL && !WriteStats(statsFilename, modeStats))
+	{
+
+		fprintf(stderr, "Couldn't write stats file %s\n", statsFilename);
+		return 1;
+
+	}
+
+	// Every search mode but weighted A* is optimal, so any query that doesn't match A* (or for weighted A*, exceeds its bound) is a regression
+	// ARA* runs until it has the shortest path, so it's held to A*'s costs too
+	if (mismatchCount > 0)
+	{
+
+		printf("\n%d queries didn't match the A* path cost (or weighted A*'s bound on it)\n", mismatchCount);
+		return 1;
+
+	}
+
+	return 0;
+
+}
@@ -0,0 +1,416 @@
+// ConnectedComponents.cpp
+
+#include "ConnectedComponents.h"
+#include <algorithm>
+#include <stddef.h>
+#include <stdlib.h>
+
+// Most cells a flood around a new obstacle can reach before the labels are left to be rebuilt instead
+const int SPLIT_SEARCH_LIMIT = 4096;
+
+ConnectedComponents::ConnectedComponents()
+{
+
+	builtGrid = NULL;
+	builtVersion = 0;
+
+}
+
+ConnectedComponents::~ConnectedComponents()
+{
+
+	builtGrid = NULL;
+
+}
+
+// Label every passable cell in the grid, flood filling one region at a time
+void ConnectedComponents::Build(Grid* grid)
+{
+
+	labels.assign(grid->GetCellCount(), -1);
+	parents.clear();
+	sizes.clear();
+
+	std::vector<int> stack;
+
+	for (int start = 0; start < grid->GetCellCount(); start++)
+	{
+
+		if (labels[start] != -1 || grid->IsObstacle(start))
+		{
+
+			continue;
+
+		}
+
+		int label = AddLabel();
+		labels[start] = label;
+		stack.push_back(start);
+
+		while (!stack.empty())
+		{
+
+			int index = stack.back();
+			stack.pop_back();
+
+			// Regions follow the same moves as the search, so any passable neighbour is connected
+			unsigned int passable = grid->GetNeighbourMask(grid->GetX(index), grid->GetY(index));
+
+			for (int i = 0; i < DIRECTION_COUNT; i++)
+			{
+
+				int neighbour = index + grid->GetNeighbourOffset(i);
+
+				if ((passable & (1u << i)) != 0 && labels[neighbour] == -1)
+				{
+
+					labels[neighbour] = label;
+					stack.push_back(neighbour);
+
+				}
+
+			}
+
+			sizes[label]++;
+
+		}
+
+	}
+
+	builtGrid = grid;
+	builtVersion = grid->GetVersion();
+
+}
+
+// Update the labels after a single cell's obstacle state has changed
+void ConnectedComponents::UpdateCell(int index)
+{
+
+	// Only a single edit since the labels were last current can be applied in place
+	if (builtGrid == NULL || builtGrid->GetVersion() != builtVersion + 1)
+	{
+
+		return;
+
+	}
+
+	Grid* grid = builtGrid;
+	int x = grid->GetX(index);
+	int y = grid->GetY(index);
+	bool isObstacle = grid->IsObstacle(index);
+
+	if (!isObstacle && labels[index] == -1)
+	{
+
+		// A cleared cell joins every region around it into one, taking that region's label; only an isolated cell needs a new one
+		unsigned int passable = grid->GetNeighbourMask(x, y);
+		int label = -1;
+
+		for (int i = 0; i < DIRECTION_COUNT; i++)
+		{
+
+			int neighbour = index + grid->GetNeighbourOffset(i);
+
+			if ((passable & (1u << i)) != 0)
+			{
+
+				label = label == -1 ? FindRoot(labels[neighbour]) : Merge(label, labels[neighbour]);
+
+			}
+
+		}
+
+		if (label == -1)
+		{
+
+			label = AddLabel();
+
+		}
+
+		labels[index] = label;
+		sizes[FindRoot(label)]++;
+
+	}
+	else if (isObstacle && labels[index] != -1)
+	{
+
+		sizes[FindRoot(labels[index])]--;
+		labels[index] = -1;
+
+		// A new obstacle can only split its region if it was holding separate parts of its neighbourhood together,
+		// and those parts are usually still joined by a short way round it
+		if (!IsSafeToRemove(x, y) && !SplitRegion(index))
+		{
+
+			return;
+
+		}
+
+	}
+
+	builtVersion = grid->GetVersion();
+
+}
+
+// Find out whether the parts of a new obstacle's neighbourhood are still connected, giving any part that's been cut off its own label
+bool ConnectedComponents::SplitRegion(int index)
+{
+
+	Grid* grid = builtGrid;
+	unsigned int passable = grid->GetNeighbourMask(grid->GetX(index), grid->GetY(index));
+
+	// One passable neighbour from each part of the neighbourhood that's connected without passing through the new obstacle
+	std::vector<int> parts;
+	unsigned int remaining = passable;
+
+	while (remaining != 0)
+	{
+
+		unsigned int seed = remaining & (~remaining + 1);
+		remaining &= ~GetConnectedNeighbours(passable, seed);
+
+		for (int i = 0; i < DIRECTION_COUNT; i++)
+		{
+
+			if (seed == (1u << i))
+			{
+
+				parts.push_back(index + grid->GetNeighbourOffset(i));
+
+			}
+
+		}
+
+	}
+
+	// Flood out from each part in turn: parts it reaches are still joined to it, and a part that runs out of cells before reaching
+	// the rest has been cut off; give up if a full round of floods hits the size limit without learning anything
+	std::vector<int> cells;
+	std::unordered_set<int> reached;
+	size_t part = 0;
+	size_t unchangedCount = 0;
+
+	while (parts.size() > 1 && unchangedCount < parts.size())
+	{
+
+		size_t partCount = parts.size();
+		int start = parts[part];
+		bool isEnclosed = FloodPart(start, parts, &cells, &reached);
+
+		parts.erase(std::remove_if(parts.begin(), parts.end(), [&](int cell) { return cell != start && reached.count(cell) != 0; }), parts.end());
+		part = std::find(parts.begin(), parts.end(), start) - parts.begin();
+
+		if (isEnclosed && parts.size() > 1)
+		{
+
+			int root = FindRoot(labels[start]);
+			int label = AddLabel();
+
+			for (int cell : cells)
+			{
+
+				labels[cell] = label;
+
+			}
+
+			sizes[label] = (int)cells.size();
+			sizes[root] -= (int)cells.size();
+
+			parts.erase(parts.begin() + part);
+
+		}
+		else
+		{
+
+			part++;
+
+		}
+
+		unchangedCount = parts.size() == partCount ? unchangedCount + 1 : 0;
+		part = parts.empty() ? 0 : part % parts.size();
+
+	}
+
+	return parts.size() <= 1;
+
+}
+
+// Flood out from a cell until every other part has been reached, nothing more can be reached, or the flood grows too large
+bool ConnectedComponents::FloodPart(int start, const std::vector<int>& parts, std::vector<int>* cells, std::unordered_set<int>* reached)
+{
+
+	cells->clear();
+	reached->clear();
+
+	cells->push_back(start);
+	reached->insert(start);
+
+	int unreachedCount = (int)parts.size() - 1;
+
+	for (size_t i = 0; i < cells->size(); i++)
+	{
+
+		if ((int)cells->size() > SPLIT_SEARCH_LIMIT)
+		{
+
+			return false;
+
+		}
+
+		int cell = (*cells)[i];
+		unsigned int passable = builtGrid->GetNeighbourMask(builtGrid->GetX(cell), builtGrid->GetY(cell));
+
+		for (int j = 0; j < DIRECTION_COUNT; j++)
+		{
+
+			int neighbour = cell + builtGrid->GetNeighbourOffset(j);
+
+			if ((passable & (1u << j)) == 0 || !reached->insert(neighbour).second)
+			{
+
+				continue;
+
+			}
+
+			cells->push_back(neighbour);
+
+			if (std::find(parts.begin(), parts.end(), neighbour) != parts.end() && --unreachedCount == 0)
+			{
+
+				return false;
+
+			}
+
+		}
+
+	}
+
+	return true;
+
+}
+
+// Get whether two cells are passable and lie in the same region
+bool ConnectedComponents::AreConnected(int indexA, int indexB)
+{
+
+	if (labels[indexA] == -1 || labels[indexB] == -1)
+	{
+
+		return false;
+
+	}
+
+	return FindRoot(labels[indexA]) == FindRoot(labels[indexB]);
+
+}
+
+// Follow merged labels up to the label that represents the whole region
+int ConnectedComponents::FindRoot(int label)
+{
+
+	while (parents[label] != label)
+	{
+
+		label = parents[label];
+
+	}
+
+	return label;
+
+}
+
+// Make a new label for a region of a single cell
+int ConnectedComponents::AddLabel()
+{
+
+	int label = (int)parents.size();
+
+	parents.push_back(label);
+	sizes.push_back(0);
+
+	return label;
+
+}
+
+// Merge the regions of two labels, attaching the smaller region to the larger
+int ConnectedComponents::Merge(int labelA, int labelB)
+{
+
+	int rootA = FindRoot(labelA);
+	int rootB = FindRoot(labelB);
+
+	if (rootA == rootB)
+	{
+
+		return rootA;
+
+	}
+
+	if (sizes[rootA] < sizes[rootB])
+	{
+
+		int swap = rootA;
+		rootA = rootB;
+		rootB = swap;
+
+	}
+
+	parents[rootB] = rootA;
+	sizes[rootA] += sizes[rootB];
+
+	return rootA;
+
+}
+
+// Get whether removing a cell can't split its region
+// Its passable neighbours stay connected without it if they're all joined to each other within the neighbourhood;
+// neighbours that are only joined by a longer route around are left to SplitRegion
+bool ConnectedComponents::IsSafeToRemove(int x, int y)
+{
+
+	unsigned int passable = builtGrid->GetNeighbourMask(x, y);
+
+	return passable == 0 || GetConnectedNeighbours(passable, passable & (~passable + 1)) == passable;
+
+}
+
+// Get the passable neighbours connected to a starting set of them by moving between neighbours next to each other
+unsigned int ConnectedComponents::GetConnectedNeighbours(unsigned int passable, unsigned int reached)
+{
+
+	unsigned int previous = 0;
+
+	while (reached != previous)
+	{
+
+		previous = reached;
+
+		for (int i = 0; i < DIRECTION_COUNT; i++)
+		{
+
+			if ((reached & (1u << i)) == 0)
+			{
+
+				continue;
+
+			}
+
+			for (int j = 0; j < DIRECTION_COUNT; j++)
+			{
+
+				if ((passable & (1u << j)) != 0 && abs(DIRECTIONS[i].x - DIRECTIONS[j].x) <= 1 && abs(DIRECTIONS[i].y - DIRECTIONS[j].y) <= 1)
+				{
+
+					reached |= 1u << j;
+
+				}
+
+			}
+
+		}
+
+	}
+
+	return reached;
+
+}
@@ -0,0 +1,70 @@
+// ConnectedComponents class - labels every passable cell with the region of the grid it belongs to
+// Two cells are only connected by a path if they share a region, so queries between regions can be rejected without searching
+// Regions are merged in place when an obstacle is cleared; when an obstacle is added that might split its region, a flood from each
+// side checks whether they're still joined, splitting off any side that's been cut off; only floods that grow too large
+// leave the labels out of date until they're next rebuilt
+
+#ifndef _CONNECTEDCOMPONENTS_H_
+#define _CONNECTEDCOMPONENTS_H_
+
+#include <unordered_set>
+#include <vector>
+#include "Grid.h"
+
+class ConnectedComponents
+{
+
+public:
+
+	ConnectedComponents();
+	~ConnectedComponents();
+
+	// Label every passable cell in the grid from scratch
+	void Build(Grid* grid);
+	// Get whether the labels match the current obstacles in the grid
+	bool IsBuiltFor(Grid* grid) { return grid == builtGrid && grid->GetVersion() == builtVersion; }
+
+	// Update the labels after a single cell's obstacle state has changed
+	// Must be called after every edit to keep the labels current; if an edit is missed, or the check for a split region grows
+	// too large, the labels are left out of date and IsBuiltFor returns false until Build is called again
+	void UpdateCell(int index);
+
+	// Get whether two cells are passable and lie in the same region, so a path between them exists
+	bool AreConnected(int indexA, int indexB);
+	// Get the region a cell belongs to, -1 if it's an obstacle
+	int GetRegion(int index) { return labels[index] == -1 ? -1 : FindRoot(labels[index]); }
+
+private:
+
+	// Follow merged labels up to the label that represents the whole region
+	// Merges always attach the smaller region, so chains stay short without having to compress them, and reads never write
+	int FindRoot(int label);
+	// Make a new label for a region of a single cell
+	int AddLabel();
+	// Merge the regions of two labels, returning the label that represents the result
+	int Merge(int labelA, int labelB);
+	// Get whether removing a cell can't split its region, because its passable neighbours are all connected to each other
+	bool IsSafeToRemove(int x, int y);
+	// Get the passable neighbours connected to a starting set of them by moving between neighbours next to each other
+	unsigned int GetConnectedNeighbours(unsigned int passable, unsigned int reached);
+	// Find out whether the parts of a new obstacle's neighbourhood are still connected, giving any part that's been cut off
+	// its own label; returns false if that couldn't be settled without flooding too much of the grid
+	bool SplitRegion(int index);
+	// Flood out from a cell until every other part has been reached, nothing more can be reached, or the flood grows too large,
+	// filling in the cells reached; returns true only if nothing more could be reached
+	bool FloodPart(int start, const std::vector<int>& parts, std::vector<int>* cells, std::unordered_set<int>* reached);
+
+	// Label of each cell, -1 for obstacles; cells share a region if their labels have the same root
+	std::vector<int> labels;
+	// Label each label was merged into, itself for roots
+	std::vector<int> parents;
+	// Number of cells under each root label, used to attach smaller regions to larger ones
+	std::vector<int> sizes;
+
+	// The grid and grid version the labels were last brought up to date with
+	Grid* builtGrid;
+	int builtVersion;
+
+};
+
+#endif
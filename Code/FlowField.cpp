@@ -0,0 +1,290 @@
+// FlowField.cpp
+
+#include "FlowField.h"
+#include <limits.h>
+#include <stddef.h>
+
+// Cost given to cells that can't reach the goal, low enough that adding a step cost can't overflow
+const int INFINITE_COST = INT_MAX / 4;
+
+FlowField::FlowField(Grid* grid) : openSet(grid->GetCellCount())
+{
+
+	this->grid = grid;
+
+	Reset();
+
+}
+
+FlowField::~FlowField()
+{
+
+	grid = NULL;
+
+}
+
+// Forget the goal, leaving every cell unreachable
+void FlowField::Reset()
+{
+
+	goal = -1;
+
+	costs.assign(grid->GetCellCount(), INFINITE_COST);
+	directions.assign(grid->GetCellCount(), -1);
+	openSet.Clear();
+
+	builtVersion = grid->GetVersion();
+	expansionCount = 0;
+
+}
+
+// Build the field towards a goal cell from scratch
+void FlowField::Build(int goal)
+{
+
+	Reset();
+
+	this->goal = goal;
+
+	if (!grid->IsObstacle(goal))
+	{
+
+		Lower(goal, 0, -1);
+		Propagate();
+
+	}
+
+}
+
+// Repair the field after a single cell's obstacle state has changed
+void FlowField::UpdateCell(int index)
+{
+
+	if (goal == -1)
+	{
+
+		return;
+
+	}
+
+	// Only a single edit since the field was last current can be repaired in place
+	if (grid->GetVersion() != builtVersion + 1)
+	{
+
+		Build(goal);
+
+		return;
+
+	}
+
+	builtVersion = grid->GetVersion();
+	expansionCount = 0;
+
+	if (!grid->IsObstacle(index))
+	{
+
+		// A cleared cell can only make routes cheaper, so it picks up a cost from its neighbours and passes it on
+		if (index == goal)
+		{
+
+			Lower(goal, 0, -1);
+
+		}
+		else
+		{
+
+			Reconnect(index);
+
+		}
+
+		Propagate();
+
+		return;
+
+	}
+
+	if (costs[index] == INFINITE_COST)
+	{
+
+		return;
+
+	}
+
+	// A new obstacle cuts off every cell whose route to the goal ran through it: the cell and everything pointing at it, directly or not
+	std::vector<int> cutOff;
+	cutOff.push_back(index);
+	costs[index] = INFINITE_COST;
+	directions[index] = -1;
+
+	for (size_t i = 0; i < cutOff.size(); i++)
+	{
+
+		int cell = cutOff[i];
+		int x = grid->GetX(cell);
+		int y = grid->GetY(cell);
+		unsigned int passable = grid->GetNeighbourMask(x, y);
+
+		for (int direction = 0; direction < DIRECTION_COUNT; direction++)
+		{
+
+			int neighbour = cell + grid->GetNeighbourOffset(direction);
+
+			if ((passable & (1u << direction)) != 0 && costs[neighbour] != INFINITE_COST && GetNextCell(neighbour) == cell)
+			{
+
+				costs[neighbour] = INFINITE_COST;
+				directions[neighbour] = -1;
+				cutOff.push_back(neighbour);
+
+			}
+
+		}
+
+	}
+
+	// Every other cell's route is unaffected, so the cells that were cut off can find their way back through them
+	for (size_t i = 1; i < cutOff.size(); i++)
+	{
+
+		Reconnect(cutOff[i]);
+
+	}
+
+	Propagate();
+
+}
+
+// Get the cost of the shortest route from a cell to the goal
+int FlowField::GetCost(int index)
+{
+
+	return costs[index] == INFINITE_COST ? -1 : costs[index];
+
+}
+
+// Follow the field from a cell to the goal
+bool FlowField::GetPath(int start, std::vector<int>* path)
+{
+
+	path->clear();
+
+	if (costs[start] == INFINITE_COST)
+	{
+
+		return false;
+
+	}
+
+	for (int cell = start; cell != -1; cell = GetNextCell(cell))
+	{
+
+		path->push_back(cell);
+
+	}
+
+	return true;
+
+}
+
+// Give a cell a lower cost and point it at the neighbour it's reached through
+void FlowField::Lower(int index, int cost, int direction)
+{
+
+	costs[index] = cost;
+	directions[index] = (signed char)direction;
+
+	if (openSet.Contains(index))
+	{
+
+		openSet.DecreaseKey(index, cost, cost);
+
+	}
+	else
+	{
+
+		openSet.Push(index, cost, cost);
+
+	}
+
+}
+
+// Expand cells in cost order until the open set is empty, passing lower costs on to their neighbours
+// Moves cost the same in both directions, so the cost of stepping from a neighbour to this cell is the cost of the step back
+void FlowField::Propagate()
+{
+
+	while (!openSet.IsEmpty())
+	{
+
+		int current = openSet.Pop();
+		int x = grid->GetX(current);
+		int y = grid->GetY(current);
+		unsigned int passable = grid->GetNeighbourMask(x, y);
+
+		expansionCount++;
+
+		for (int direction = 0; direction < DIRECTION_COUNT; direction++)
+		{
+
+			if ((passable & (1u << direction)) == 0)
+			{
+
+				continue;
+
+			}
+
+			int neighbour = current + grid->GetNeighbourOffset(direction);
+			int cost = costs[current] + DIRECTIONS[direction].cost;
+
+			if (cost < costs[neighbour])
+			{
+
+				// The neighbour steps back the opposite way to reach this cell
+				Lower(neighbour, cost, GetDirectionIndex(-DIRECTIONS[direction].x, -DIRECTIONS[direction].y));
+
+			}
+
+		}
+
+	}
+
+}
+
+// Find the cheapest way to the goal through a cell's neighbours, pointing the cell at it
+void FlowField::Reconnect(int index)
+{
+
+	unsigned int passable = grid->GetNeighbourMask(grid->GetX(index), grid->GetY(index));
+	int bestCost = INFINITE_COST;
+	int bestDirection = -1;
+
+	for (int direction = 0; direction < DIRECTION_COUNT; direction++)
+	{
+
+		if ((passable & (1u << direction)) == 0)
+		{
+
+			continue;
+
+		}
+
+		int neighbour = index + grid->GetNeighbourOffset(direction);
+
+		if (costs[neighbour] != INFINITE_COST && costs[neighbour] + DIRECTIONS[direction].cost < bestCost)
+		{
+
+			bestCost = costs[neighbour] + DIRECTIONS[direction].cost;
+			bestDirection = direction;
+
+		}
+
+	}
+
+	if (bestDirection != -1)
+	{
+
+		Lower(index, bestCost, bestDirection);
+
+	}
+
+}
@@ -0,0 +1,70 @@
+// FlowField class - shortest route to a single goal cell from every cell in the grid at once
+// Runs one Dijkstra search outwards from the goal, recording each cell's distance to the goal and the direction to step in to get closer,
+// so any number of agents heading for the same goal can find their next step with a single lookup instead of a search each
+// Obstacle edits are repaired in place: a cleared cell spreads its lower costs outwards, and a new obstacle only resets the cells
+// whose route to the goal ran through it
+
+#ifndef _FLOWFIELD_H_
+#define _FLOWFIELD_H_
+
+#include <vector>
+#include "Grid.h"
+#include "OpenSet.h"
+
+class FlowField
+{
+
+public:
+
+	// Constructor - pass in the grid to build the field over
+	FlowField(Grid* grid);
+	~FlowField();
+
+	// Build the field towards a goal cell from scratch
+	void Build(int goal);
+	// Repair the field after a single cell's obstacle state has changed
+	// If the grid has been edited more than once since the field was last current, the field is rebuilt instead
+	void UpdateCell(int index);
+	// Forget the goal, leaving every cell unreachable
+	void Reset();
+
+	// Get whether the field has a goal and matches the current obstacles in the grid
+	bool IsBuiltFor(Grid* grid) { return grid == this->grid && goal != -1 && grid->GetVersion() == builtVersion; }
+	int GetGoal() { return goal; }
+
+	// Get the cost of the shortest route from a cell to the goal, -1 if the goal can't be reached from it
+	int GetCost(int index);
+	// Get the index into DIRECTIONS of the step from a cell towards the goal, -1 at the goal or if the goal can't be reached
+	int GetDirection(int index) { return directions[index]; }
+	// Get the next cell on the way from a cell to the goal, -1 at the goal or if the goal can't be reached
+	int GetNextCell(int index) { return directions[index] == -1 ? -1 : index + grid->GetNeighbourOffset(directions[index]); }
+	// Follow the field from a cell to the goal, returning true and filling in the path (cell to goal) if the goal can be reached
+	bool GetPath(int start, std::vector<int>* path);
+
+	// Get the number of cells expanded by the last build or repair
+	int GetExpansionCount() { return expansionCount; }
+
+private:
+
+	// Give a cell a lower cost and point it at the neighbour it's reached through, adding or moving it in the open set
+	void Lower(int index, int cost, int direction);
+	// Expand cells in cost order until the open set is empty, passing lower costs on to their neighbours
+	void Propagate();
+	// Find the cheapest way to the goal through a cell's neighbours, pointing the cell at it
+	void Reconnect(int index);
+
+	Grid* grid;
+	int goal;
+
+	// Cost from each cell to the goal, and the direction each cell steps in to get there
+	std::vector<int> costs;
+	std::vector<signed char> directions;
+	OpenSet openSet;
+
+	// Grid version the field was last made current with
+	int builtVersion;
+	int expansionCount;
+
+};
+
+#endif
@@ -0,0 +1,201 @@
+// Grid.cpp
+
+#include "Grid.h"
+#include "Heuristic.h"
+
+const Direction DIRECTIONS[DIRECTION_COUNT] =
+{
+	{ -1, 0, STRAIGHT_COST },
+	{ 1, 0, STRAIGHT_COST },
+	{ 0, -1, STRAIGHT_COST },
+	{ 0, 1, STRAIGHT_COST },
+	{ -1, -1, DIAGONAL_COST },
+	{ 1, -1, DIAGONAL_COST },
+	{ -1, 1, DIAGONAL_COST },
+	{ 1, 1, DIAGONAL_COST }
+};
+
+// Find the index into DIRECTIONS of a unit offset
+int GetDirectionIndex(int x, int y)
+{
+
+	for (int i = 0; i < DIRECTION_COUNT; i++)
+	{
+
+		if (DIRECTIONS[i].x == x && DIRECTIONS[i].y == y)
+		{
+
+			return i;
+
+		}
+
+	}
+
+	return -1;
+
+}
+
+// Set every bit of a layer that lies within the grid, leaving the guard words and lines as obstacles
+static void FillLayer(std::vector<uint64_t>* bits, int wordsPerLine, int lineCount, int lineLength)
+{
+
+	bits->assign((lineCount + 2) * wordsPerLine, 0);
+
+	for (int line = 0; line < lineCount; line++)
+	{
+
+		uint64_t* words = &(*bits)[((line + 1) * wordsPerLine) + 1];
+
+		for (int position = 0; position < lineLength; position += 64)
+		{
+
+			int count = lineLength - position;
+			words[position >> 6] = count >= 64 ? ~(uint64_t)0 : ((uint64_t)1 << count) - 1;
+
+		}
+
+	}
+
+}
+
+Grid::Grid(int width, int height)
+{
+
+	this->width = width;
+	this->height = height;
+
+	version = 0;
+
+	// A guard word at each end of every line, plus a guard line at each end of each layer
+	wordsPerRow = ((width + 63) >> 6) + 2;
+	wordsPerColumn = ((height + 63) >> 6) + 2;
+
+	for (int i = 0; i < DIRECTION_COUNT; i++)
+	{
+
+		neighbourOffsets[i] = DIRECTIONS[i].x + (DIRECTIONS[i].y * width);
+
+	}
+
+	// Work out once which directions leave the grid from each kind of edge, so neighbour loops don't need edge cases
+	// A grid one cell wide or tall touches both opposite edges at once, which the combined bits handle
+	for (int edges = 0; edges < 16; edges++)
+	{
+
+		inBoundsMasks[edges] = 0;
+
+		for (int i = 0; i < DIRECTION_COUNT; i++)
+		{
+
+			bool isLeaving = (DIRECTIONS[i].x < 0 && (edges & 1)) || (DIRECTIONS[i].x > 0 && (edges & 2)) ||
+				(DIRECTIONS[i].y < 0 && (edges & 4)) || (DIRECTIONS[i].y > 0 && (edges & 8));
+
+			if (!isLeaving)
+			{
+
+				inBoundsMasks[edges] |= 1u << i;
+
+			}
+
+		}
+
+	}
+
+	ClearObstacles();
+
+	version = 0;
+
+}
+
+Grid::~Grid()
+{
+
+}
+
+// Set or clear the obstacle state of a cell
+void Grid::SetObstacle(int index, bool isObstacle)
+{
+
+	SetPassable(GetX(index), GetY(index), !isObstacle);
+
+	version++;
+
+}
+
+// Clear every obstacle in the grid
+void Grid::ClearObstacles()
+{
+
+	FillLayer(&rowBits, wordsPerRow, height, width);
+	FillLayer(&columnBits, wordsPerColumn, width, height);
+
+	version++;
+
+}
+
+// Get a mask of the passable cells in a cell's Moore neighbourhood
+unsigned int Grid::GetNeighbourMask(int x, int y)
+{
+
+	// Three cells from each of the rows above, through and below the cell, left to right
+	unsigned int above = (unsigned int)GetRowBits(x - 1, y - 1) & 7;
+	unsigned int middle = (unsigned int)GetRowBits(x - 1, y) & 7;
+	unsigned int below = (unsigned int)GetRowBits(x - 1, y + 1) & 7;
+
+	// Rearrange them into DIRECTIONS order: left, right, up, down, then up-left, up-right, down-left, down-right
+	return (middle & 1) |
+		((middle >> 1) & 2) |
+		((above & 2) << 1) |
+		((below & 2) << 2) |
+		((above & 1) << 4) |
+		((above & 4) << 3) |
+		((below & 1) << 6) |
+		((below & 4) << 5);
+
+}
+
+// Read 64 bits from a line of a bit layer, starting at a position along the line
+uint64_t Grid::ReadBits(const std::vector<uint64_t>& bits, int wordsPerLine, int line, int position)
+{
+
+	// Lines and positions are shifted past the guard line and guard word at the start
+	int bit = position + 64;
+	const uint64_t* words = &bits[((line + 1) * wordsPerLine) + (bit >> 6)];
+	int shift = bit & 63;
+
+	if (shift == 0)
+	{
+
+		return words[0];
+
+	}
+
+	return (words[0] >> shift) | (words[1] << (64 - shift));
+
+}
+
+// Set a cell's bit in both layers
+void Grid::SetPassable(int x, int y, bool isPassable)
+{
+
+	uint64_t& rowWord = rowBits[GetRowWord(x, y)];
+	uint64_t& columnWord = columnBits[((x + 1) * wordsPerColumn) + ((y + 64) >> 6)];
+	uint64_t rowBit = (uint64_t)1 << ((x + 64) & 63);
+	uint64_t columnBit = (uint64_t)1 << ((y + 64) & 63);
+
+	if (isPassable)
+	{
+
+		rowWord |= rowBit;
+		columnWord |= columnBit;
+
+	}
+	else
+	{
+
+		rowWord &= ~rowBit;
+		columnWord &= ~columnBit;
+
+	}
+
+}
@@ -0,0 +1,133 @@
+// Grid class - headless storage for the cells the pathfinder searches over
+// Holds grid dimensions and obstacle state, with no dependency on SFML
+// Obstacles are bit-packed one bit per cell into 64-bit words, once row by row and once column by column, so searches can
+// read 64 cells along a row or column in a couple of operations and the whole occupancy layer stays small enough to keep in cache
+
+#ifndef _GRID_H_
+#define _GRID_H_
+
+#include <stdint.h>
+#include <vector>
+
+#if defined(_MSC_VER)
+#include <intrin.h>
+#endif
+
+// Offset and step cost for one cell of the Moore neighbourhood
+struct Direction
+{
+	int x;
+	int y;
+	int cost;
+};
+
+// The eight Moore neighbourhood directions; the four straight directions come first, followed by the diagonals
+const int DIRECTION_COUNT = 8;
+extern const Direction DIRECTIONS[DIRECTION_COUNT];
+
+// Find the index into DIRECTIONS of a unit offset, -1 if the offset isn't a direction
+int GetDirectionIndex(int x, int y);
+
+// Find the position of the lowest or highest set bit of a word; the word must not be 0
+inline int FindLowestBit(uint64_t word)
+{
+
+#if defined(_MSC_VER)
+	unsigned long position;
+	_BitScanForward64(&position, word);
+	return (int)position;
+#else
+	return __builtin_ctzll(word);
+#endif
+
+}
+
+inline int FindHighestBit(uint64_t word)
+{
+
+#if defined(_MSC_VER)
+	unsigned long position;
+	_BitScanReverse64(&position, word);
+	return (int)position;
+#else
+	return 63 - __builtin_clzll(word);
+#endif
+
+}
+
+class Grid
+{
+
+public:
+
+	// Constructor - pass in the number of cells along each axis
+	Grid(int width, int height);
+	~Grid();
+
+	// Get the grid dimensions
+	int GetWidth() { return width; }
+	int GetHeight() { return height; }
+	int GetCellCount() { return width * height; }
+
+	// Convert between grid coordinates and flat cell indices
+	int GetIndex(int x, int y) { return (width * y) + x; }
+	int GetX(int index) { return index % width; }
+	int GetY(int index) { return index / width; }
+	// Check whether a pair of grid coordinates lies within the grid
+	bool IsInBounds(int x, int y) { return x >= 0 && y >= 0 && x < width && y < height; }
+	// Check whether a pair of grid coordinates lies within the grid and isn't an obstacle
+	bool IsPassable(int x, int y) { return IsInBounds(x, y) && ((rowBits[GetRowWord(x, y)] >> ((x + 64) & 63)) & 1) != 0; }
+
+	// Get whether the cell is an obstacle
+	bool IsObstacle(int index) { return !IsPassable(GetX(index), GetY(index)); }
+
+	// Get the passability of 64 cells along a row or column, starting at (x, y) and moving right or down
+	// Bit i is set if the cell i steps along is passable; cells outside the grid read as obstacles
+	// The start can be up to 64 cells before the grid and the line can be one row or column outside it, so scans don't need bounds checks
+	uint64_t GetRowBits(int x, int y) { return ReadBits(rowBits, wordsPerRow, y, x); }
+	uint64_t GetColumnBits(int x, int y) { return ReadBits(columnBits, wordsPerColumn, x, y); }
+	// Get a mask of the passable cells in a cell's Moore neighbourhood, with bit i set if DIRECTIONS[i] leads to a passable cell
+	unsigned int GetNeighbourMask(int x, int y);
+	// Get a mask of the directions that stay within the grid from a cell, whether or not the neighbour is an obstacle
+	unsigned int GetInBoundsMask(int x, int y) { return inBoundsMasks[(x == 0) | ((x == width - 1) << 1) | ((y == 0) << 2) | ((y == height - 1) << 3)]; }
+	// Get the amount to add to a cell's index to get the index of its neighbour in a direction (an index into DIRECTIONS)
+	int GetNeighbourOffset(int direction) { return neighbourOffsets[direction]; }
+
+	// Set or clear the obstacle state of a cell
+	void SetObstacle(int index, bool isObstacle);
+	// Clear every obstacle in the grid
+	void ClearObstacles();
+
+	// Get a counter that changes every time the obstacles are edited, so precomputed data can tell when it's out of date
+	int GetVersion() { return version; }
+
+private:
+
+	int width;
+	int height;
+
+	int version;
+
+	// Index offset of each neighbour, so neighbours are found without converting back to coordinates
+	int neighbourOffsets[DIRECTION_COUNT];
+	// In-bounds direction masks for every combination of edges a cell can touch, indexed by a bit per edge (left, right, top, bottom)
+	unsigned int inBoundsMasks[16];
+
+	// Get the word of rowBits holding a cell
+	int GetRowWord(int x, int y) { return ((y + 1) * wordsPerRow) + ((x + 64) >> 6); }
+	// Read 64 bits from a line of a bit layer, starting at a position along the line
+	uint64_t ReadBits(const std::vector<uint64_t>& bits, int wordsPerLine, int line, int position);
+	// Set a cell's bit in both layers
+	void SetPassable(int x, int y, bool isPassable);
+
+	// Passability bit for each cell (set if passable), stored row by row and again column by column
+	// Each line has a guard word of obstacles before and after it, and there's a guard line before and after the grid,
+	// so reads that run off an edge see obstacles without any bounds checks
+	std::vector<uint64_t> rowBits;
+	std::vector<uint64_t> columnBits;
+	int wordsPerRow;
+	int wordsPerColumn;
+
+};
+
+#endif
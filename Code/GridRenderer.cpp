@@ -0,0 +1,528 @@
+// GridRenderer.cpp
+
+#include "GridRenderer.h"
+#include <algorithm>
+#include <math.h>
+
+// Character size of the cost labels, in pixels
+static const unsigned int CHARACTER_SIZE = 10;
+// Longest label: two costs of up to seven characters each, with four spaces between them
+static const int LABEL_LENGTH = 18;
+// Cells smaller than this on screen (in pixels) are too small to read a label, so labels aren't built at all
+static const float MIN_LABEL_CELL_SIZE = 40.0f;
+
+// Cell colours for each state
+static const sf::Color BLANK_COLOUR(255, 255, 255);
+static const sf::Color OBSTACLE_COLOUR(0, 0, 0);
+static const sf::Color OPEN_COLOUR(100, 255, 10);
+static const sf::Color CLOSED_COLOUR(10, 125, 255);
+static const sf::Color PATH_COLOUR(162, 20, 245);
+static const sf::Color LABEL_COLOUR(0, 0, 0);
+
+GridRenderer::GridRenderer(int width, int height, float cellSize, sf::Font* font) : quads(sf::Quads), labels(sf::Quads), markers(sf::Quads), gCosts(width * height, 0), fCosts(width * height, 0)
+{
+
+	this->width = width;
+	this->height = height;
+	this->cellSize = cellSize;
+	this->font = font;
+
+	int cellCount = width * height;
+
+	colours.assign(cellCount, BLANK_COLOUR);
+	hasCosts.assign(cellCount, false);
+	selected.assign(cellCount, false);
+	isDirty.assign(cellCount, false);
+
+	visibleFirstRow = 0;
+	visibleLastRow = -1;
+	visibleFirstColumn = 0;
+	visibleLastColumn = -1;
+	areQuadsBuilt = false;
+	areLabelsBuilt = false;
+
+	// Load every glyph a label can use up front, so the font texture doesn't change while labels are being built
+	const char* characters = "0123456789- ";
+
+	for (const char* character = characters; *character != '\0'; character++)
+	{
+
+		font->getGlyph(*character, CHARACTER_SIZE, false);
+
+	}
+
+}
+
+GridRenderer::~GridRenderer()
+{
+
+	font = NULL;
+
+}
+
+// Draw the cells that are on screen in one call, then their labels in another
+void GridRenderer::Render(sf::RenderWindow* window)
+{
+
+	// Find the range of rows and columns that overlaps the view
+	const sf::View& view = window->getView();
+	sf::Vector2f viewTopLeft = view.getCenter() - (view.getSize() * 0.5f);
+	sf::Vector2f viewBottomRight = view.getCenter() + (view.getSize() * 0.5f);
+	int firstRow = std::max(0, (int)floor(viewTopLeft.y / cellSize));
+	int lastRow = std::min(height - 1, (int)floor(viewBottomRight.y / cellSize));
+	int firstColumn = std::max(0, (int)floor(viewTopLeft.x / cellSize));
+	int lastColumn = std::min(width - 1, (int)floor(viewBottomRight.x / cellSize));
+
+	if (firstRow > lastRow || firstColumn > lastColumn)
+	{
+
+		return;
+
+	}
+
+	// Lay the slots out again if the visible range has moved, otherwise only rewrite the cells that have changed
+	if (!areQuadsBuilt || firstRow != visibleFirstRow || lastRow != visibleLastRow || firstColumn != visibleFirstColumn || lastColumn != visibleLastColumn)
+	{
+
+		visibleFirstRow = firstRow;
+		visibleLastRow = lastRow;
+		visibleFirstColumn = firstColumn;
+		visibleLastColumn = lastColumn;
+
+		BuildQuads();
+		areLabelsBuilt = false;
+
+	}
+	else
+	{
+
+		for (int index : dirtyCells)
+		{
+
+			WriteQuad(index);
+
+		}
+
+	}
+
+	// Skip labels entirely when cells are too small on screen to read them; they're laid out again once they're readable
+	float scale = window->getSize().x / view.getSize().x;
+	bool showLabels = cellSize * scale >= MIN_LABEL_CELL_SIZE;
+
+	if (!showLabels)
+	{
+
+		areLabelsBuilt = false;
+
+	}
+	else if (!areLabelsBuilt)
+	{
+
+		BuildLabels();
+
+	}
+	else
+	{
+
+		for (int index : dirtyCells)
+		{
+
+			WriteLabel(index);
+
+		}
+
+	}
+
+	for (int index : dirtyCells)
+	{
+
+		isDirty[index] = false;
+
+	}
+
+	dirtyCells.clear();
+
+	window->draw(quads);
+
+	if (showLabels)
+	{
+
+		sf::RenderStates states;
+		states.texture = &font->getTexture(CHARACTER_SIZE);
+		window->draw(labels, states);
+
+	}
+
+}
+
+// Draw a marker over every listed cell that's on screen in one call
+void GridRenderer::RenderMarkers(sf::RenderWindow* window, const std::vector<int>& cells, sf::Color colour)
+{
+
+	const sf::View& view = window->getView();
+	sf::Vector2f viewTopLeft = view.getCenter() - (view.getSize() * 0.5f);
+	sf::Vector2f viewBottomRight = view.getCenter() + (view.getSize() * 0.5f);
+
+	// Markers fill the middle half of the cell, so the cell's own colour still shows around them
+	float inset = cellSize * 0.25f;
+	float size = (cellSize * 0.5f) - 1.0f;
+
+	markers.clear();
+
+	for (int index : cells)
+	{
+
+		float left = ((index % width) * cellSize) + inset;
+		float top = ((index / width) * cellSize) + inset;
+
+		if (left + size < viewTopLeft.x || top + size < viewTopLeft.y || left > viewBottomRight.x || top > viewBottomRight.y)
+		{
+
+			continue;
+
+		}
+
+		markers.append(sf::Vertex(sf::Vector2f(left, top), colour));
+		markers.append(sf::Vertex(sf::Vector2f(left + size, top), colour));
+		markers.append(sf::Vertex(sf::Vector2f(left + size, top + size), colour));
+		markers.append(sf::Vertex(sf::Vector2f(left, top + size), colour));
+
+	}
+
+	window->draw(markers);
+
+}
+
+// Find the cell under a pixel of the window by undoing the view, then dividing by the cell spacing
+int GridRenderer::GetCellAt(sf::RenderWindow* window, sf::Vector2i pixel)
+{
+
+	sf::Vector2f position = window->mapPixelToCoords(pixel);
+
+	int x = (int)floor(position.x / cellSize);
+	int y = (int)floor(position.y / cellSize);
+
+	if (x < 0 || y < 0 || x >= width || y >= height)
+	{
+
+		return -1;
+
+	}
+
+	return (width * y) + x;
+
+}
+
+// Select the cell and indicate to the user that it's been selected
+void GridRenderer::Select(int index, sf::Color colour)
+{
+
+	SetColour(index, colour);
+
+	selected[index] = true;
+
+}
+
+// Deselect the cell
+void GridRenderer::Deselect(int index)
+{
+
+	ResetCell(index);
+
+	selected[index] = false;
+
+}
+
+// Colour the cell black to show it's an obstacle
+void GridRenderer::SetObstacle(int index)
+{
+
+	SetColour(index, OBSTACLE_COLOUR);
+
+}
+
+// Reset the cell back to default
+void GridRenderer::ResetCell(int index)
+{
+
+	SetColour(index, BLANK_COLOUR);
+
+	hasCosts[index] = false;
+
+}
+
+// Colour the cell to show it's in the open set
+void GridRenderer::SetToOpen(int index)
+{
+
+	SetColour(index, OPEN_COLOUR);
+
+}
+
+// Colour the cell to show it's in the closed set
+void GridRenderer::SetToClosed(int index)
+{
+
+	SetColour(index, CLOSED_COLOUR);
+
+}
+
+// Indicate that this cell is part of the output path
+void GridRenderer::SetToPath(int index)
+{
+
+	SetColour(index, PATH_COLOUR);
+
+}
+
+// Set the costs shown on a cell's label
+void GridRenderer::SetCosts(int index, int gCost, int fCost)
+{
+
+	// Search state is shown every frame, so most calls don't change anything
+	if (hasCosts[index] && gCosts.Get(index) == gCost && fCosts.Get(index) == fCost)
+	{
+
+		return;
+
+	}
+
+	gCosts[index] = gCost;
+	fCosts[index] = fCost;
+	hasCosts[index] = true;
+
+	MarkDirty(index);
+
+}
+
+// Set the colour of a cell
+void GridRenderer::SetColour(int index, sf::Color colour)
+{
+
+	colours[index] = colour;
+
+	MarkDirty(index);
+
+}
+
+// Queue a cell's quad and label to be rewritten the next time it's drawn
+// Cells off screen don't need queueing, as every slot is written when the visible range next moves
+void GridRenderer::MarkDirty(int index)
+{
+
+	if (!isDirty[index] && areQuadsBuilt && GetSlot(index) != -1)
+	{
+
+		isDirty[index] = true;
+		dirtyCells.push_back(index);
+
+	}
+
+}
+
+// Get the slot of a cell within the visible range
+int GridRenderer::GetSlot(int index)
+{
+
+	int x = index % width;
+	int y = index / width;
+
+	// Cells outside the visible range don't have a slot; they're written when the range next moves over them
+	if (x < visibleFirstColumn || x > visibleLastColumn || y < visibleFirstRow || y > visibleLastRow)
+	{
+
+		return -1;
+
+	}
+
+	return ((y - visibleFirstRow) * (visibleLastColumn - visibleFirstColumn + 1)) + (x - visibleFirstColumn);
+
+}
+
+// Rebuild the quads for every cell in the visible range
+void GridRenderer::BuildQuads()
+{
+
+	int slotCount = (visibleLastRow - visibleFirstRow + 1) * (visibleLastColumn - visibleFirstColumn + 1);
+
+	quads.resize(slotCount * 4);
+
+	for (int y = visibleFirstRow; y <= visibleLastRow; y++)
+	{
+
+		for (int x = visibleFirstColumn; x <= visibleLastColumn; x++)
+		{
+
+			WriteQuad((width * y) + x);
+
+		}
+
+	}
+
+	areQuadsBuilt = true;
+
+}
+
+// Rebuild the label slots for every cell in the visible range
+void GridRenderer::BuildLabels()
+{
+
+	int slotCount = (visibleLastRow - visibleFirstRow + 1) * (visibleLastColumn - visibleFirstColumn + 1);
+
+	labels.resize(slotCount * LABEL_LENGTH * 4);
+
+	for (int y = visibleFirstRow; y <= visibleLastRow; y++)
+	{
+
+		for (int x = visibleFirstColumn; x <= visibleLastColumn; x++)
+		{
+
+			WriteLabel((width * y) + x);
+
+		}
+
+	}
+
+	areLabelsBuilt = true;
+
+}
+
+// Write a cell's quad into its slot, leaving a one pixel gap to the next cell so the grid lines show through
+void GridRenderer::WriteQuad(int index)
+{
+
+	int slot = GetSlot(index);
+
+	if (slot == -1)
+	{
+
+		return;
+
+	}
+
+	sf::Vertex* quad = &quads[slot * 4];
+	float left = (index % width) * cellSize;
+	float top = (index / width) * cellSize;
+	float size = cellSize - 1.0f;
+
+	quad[0] = sf::Vertex(sf::Vector2f(left, top), colours[index]);
+	quad[1] = sf::Vertex(sf::Vector2f(left + size, top), colours[index]);
+	quad[2] = sf::Vertex(sf::Vector2f(left + size, top + size), colours[index]);
+	quad[3] = sf::Vertex(sf::Vector2f(left, top + size), colours[index]);
+
+}
+
+// Write a number's digits into a buffer, returning the number of characters written
+static int FormatNumber(int value, char* buffer)
+{
+
+	char digits[12];
+	int count = 0;
+	unsigned int magnitude = value < 0 ? 0u - (unsigned int)value : (unsigned int)value;
+
+	do
+	{
+
+		digits[count++] = (char)('0' + (magnitude % 10));
+		magnitude /= 10;
+
+	} while (magnitude > 0);
+
+	int length = 0;
+
+	if (value < 0)
+	{
+
+		buffer[length++] = '-';
+
+	}
+
+	while (count > 0)
+	{
+
+		buffer[length++] = digits[--count];
+
+	}
+
+	return length;
+
+}
+
+// Write the glyph quads for a cell's label into its slot, laid out the same way sf::Text would
+// Quads the label doesn't use are collapsed to a point, so they draw nothing
+void GridRenderer::WriteLabel(int index)
+{
+
+	int slot = GetSlot(index);
+
+	if (slot == -1)
+	{
+
+		return;
+
+	}
+
+	int x = index % width;
+	int y = index / width;
+	sf::Vertex* quad = &labels[slot * LABEL_LENGTH * 4];
+
+	char text[LABEL_LENGTH * 2];
+	int length = 0;
+
+	if (hasCosts[index])
+	{
+
+		length += FormatNumber(gCosts.Get(index), text);
+		text[length++] = ' ';
+		text[length++] = ' ';
+		text[length++] = ' ';
+		text[length++] = ' ';
+		length += FormatNumber(fCosts.Get(index), text + length);
+		length = std::min(length, LABEL_LENGTH);
+
+	}
+
+	// Labels sit along the bottom quarter of the cell, with the baseline one character height below the top of the text
+	float size = cellSize - 1.0f;
+	float penX = (x * cellSize) + 1.0f;
+	float baseline = (y * cellSize) + ((size / 4) * 3) + CHARACTER_SIZE;
+
+	for (int i = 0; i < LABEL_LENGTH; i++, quad += 4)
+	{
+
+		if (i >= length)
+		{
+
+			for (int corner = 0; corner < 4; corner++)
+			{
+
+				quad[corner].position = sf::Vector2f(penX, baseline);
+
+			}
+
+			continue;
+
+		}
+
+		const sf::Glyph& glyph = font->getGlyph(text[i], CHARACTER_SIZE, false);
+
+		float left = penX + glyph.bounds.left;
+		float top = baseline + glyph.bounds.top;
+		float right = left + glyph.bounds.width;
+		float bottom = top + glyph.bounds.height;
+
+		float textureLeft = (float)glyph.textureRect.left;
+		float textureTop = (float)glyph.textureRect.top;
+		float textureRight = textureLeft + glyph.textureRect.width;
+		float textureBottom = textureTop + glyph.textureRect.height;
+
+		quad[0] = sf::Vertex(sf::Vector2f(left, top), LABEL_COLOUR, sf::Vector2f(textureLeft, textureTop));
+		quad[1] = sf::Vertex(sf::Vector2f(right, top), LABEL_COLOUR, sf::Vector2f(textureRight, textureTop));
+		quad[2] = sf::Vertex(sf::Vector2f(right, bottom), LABEL_COLOUR, sf::Vector2f(textureRight, textureBottom));
+		quad[3] = sf::Vertex(sf::Vector2f(left, bottom), LABEL_COLOUR, sf::Vector2f(textureLeft, textureBottom));
+
+		penX += glyph.advance;
+
+	}
+
+}
@@ -0,0 +1,100 @@
+// GridRenderer class - handles rendering of every grid cell in a handful of draw calls
+// Only the cells on screen have quads, batched into a single vertex array; cost labels are batched into one glyph vertex array
+// Quads and labels are only rewritten when a cell changes or the view moves, and labels are skipped when cells are too small to read
+// Per-cell storage is a colour plus a few bits, with label costs paged in for cells the search reaches, so huge grids stay small
+// Search state lives in the Pathfinder; the renderer only displays it
+
+#ifndef _GRIDRENDERER_H_
+#define _GRIDRENDERER_H_
+
+#include <vector>
+#include <SFML/Graphics.hpp>
+#include "PagedArray.h"
+
+class GridRenderer
+{
+
+public:
+
+	// Constructor - pass in the grid dimensions, the spacing between cells and the font for the cost labels
+	// Cells are laid out once in world coordinates; panning and zooming are left to the window's view
+	GridRenderer(int width, int height, float cellSize, sf::Font* font);
+	~GridRenderer();
+
+	// Render the cells and cost labels that fall within the window's current view
+	void Render(sf::RenderWindow* window);
+	// Render a small marker in the middle of each of a list of cells that falls within the view, such as the cells agents stand on
+	void RenderMarkers(sf::RenderWindow* window, const std::vector<int>& cells, sf::Color colour);
+
+	// Find the cell under a pixel of the window, -1 if there isn't one
+	// The pixel is mapped through the window's view, so this stays correct however the view is moved or zoomed
+	int GetCellAt(sf::RenderWindow* window, sf::Vector2i pixel);
+	bool IsSelected(int index) { return selected[index]; }
+
+	// Show the cell as an obstacle
+	void SetObstacle(int index);
+	// Reset the cell to blank
+	void ResetCell(int index);
+	// Show the cell as part of the open set
+	void SetToOpen(int index);
+	// Show the cell as part of the closed set
+	void SetToClosed(int index);
+	// Show the cell as part of the final path
+	void SetToPath(int index);
+
+	// Select a cell to display user selected cells for the A* algorithm and obstacle creation
+	void Select(int index, sf::Color colour);
+	// Deselect a cell that has been selected by the user
+	void Deselect(int index);
+	// Set the costs shown on a cell's label
+	void SetCosts(int index, int gCost, int fCost);
+
+private:
+
+	// Set the colour of a cell
+	void SetColour(int index, sf::Color colour);
+	// Queue a cell's quad and label to be rewritten the next time it's drawn, if it's on screen
+	void MarkDirty(int index);
+	// Get the slot of a cell within the visible range, -1 if the cell isn't visible
+	int GetSlot(int index);
+	// Rebuild the quads or label slots for every cell in the visible range
+	void BuildQuads();
+	void BuildLabels();
+	// Write a cell's quad into its slot in the quad vertex array
+	void WriteQuad(int index);
+	// Write the glyph quads for a cell's label into its slot in the label vertex array
+	void WriteLabel(int index);
+
+	int width;
+	int height;
+	float cellSize;
+
+	sf::Font* font;
+
+	// Quads for the visible cells, one slot of four vertices per cell laid out row by row across the visible range
+	sf::VertexArray quads;
+	// Glyph quads for the labels of the visible cells, with a fixed slot of quads per cell so one label can be rewritten alone
+	sf::VertexArray labels;
+	// Quads for the markers drawn by the last call to RenderMarkers, kept so their storage is reused between frames
+	sf::VertexArray markers;
+	// Range of cells the slots were laid out for; the slots are rebuilt when this changes
+	int visibleFirstRow;
+	int visibleLastRow;
+	int visibleFirstColumn;
+	int visibleLastColumn;
+	bool areQuadsBuilt;
+	bool areLabelsBuilt;
+	// Cells that have changed since they were last written, with a flag per cell so each is only queued once
+	std::vector<int> dirtyCells;
+	std::vector<bool> isDirty;
+
+	// Per-cell colour, label costs and selection state, indexed like the grid
+	std::vector<sf::Color> colours;
+	PagedArray<int> gCosts;
+	PagedArray<int> fCosts;
+	std::vector<bool> hasCosts;
+	std::vector<bool> selected;
+
+};
+
+#endif
@@ -0,0 +1,79 @@
+// Heuristic.cpp
+
+#include "Heuristic.h"
+#include <math.h>
+#include <stdlib.h>
+
+// Estimate the cost of travelling the given distance along each axis
+int EstimateDistance(HeuristicType type, int differenceX, int differenceY)
+{
+
+	int x = abs(differenceX);
+	int y = abs(differenceY);
+
+	switch (type)
+	{
+
+	case HEURISTIC_OCTILE:
+		// Move diagonally until one axis is covered, then straight for the rest
+		if (x < y)
+		{
+
+			return (DIAGONAL_COST * x) + (STRAIGHT_COST * (y - x));
+
+		}
+
+		return (DIAGONAL_COST * y) + (STRAIGHT_COST * (x - y));
+
+	case HEURISTIC_EUCLIDEAN:
+		// Scaled so a diagonal step costs DIAGONAL_COST, as scaling by STRAIGHT_COST would overestimate long diagonals
+		// Rounded to the nearest rather than truncated, so a step never lowers the estimate by more than the step costs
+		// Squared in double precision, as squaring an axis difference of 46341 or more would overflow an int
+		return (int)((sqrt(((double)x * x) + ((double)y * y)) * (DIAGONAL_COST / sqrt(2.0))) + 0.5);
+
+	case HEURISTIC_MANHATTAN:
+		return STRAIGHT_COST * (x + y);
+
+	case HEURISTIC_CHEBYSHEV:
+		return STRAIGHT_COST * (x > y ? x : y);
+
+	default:
+		return 0;
+
+	}
+
+}
+
+// Get whether a heuristic never overestimates
+bool IsHeuristicAdmissible(HeuristicType type)
+{
+
+	return type != HEURISTIC_MANHATTAN;
+
+}
+
+// Get a readable name for a heuristic
+const char* GetHeuristicName(HeuristicType type)
+{
+
+	switch (type)
+	{
+
+	case HEURISTIC_OCTILE:
+		return "Octile";
+
+	case HEURISTIC_EUCLIDEAN:
+		return "Euclidean";
+
+	case HEURISTIC_MANHATTAN:
+		return "Manhattan";
+
+	case HEURISTIC_CHEBYSHEV:
+		return "Chebyshev";
+
+	default:
+		return "Unknown";
+
+	}
+
+}
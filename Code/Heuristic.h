@@ -0,0 +1,35 @@
+// Heuristic functions and step costs used by the pathfinder
+// All costs are integers measured in grid cells, scaled so that diagonal steps can be represented without floating point
+
+#ifndef _HEURISTIC_H_
+#define _HEURISTIC_H_
+
+// Cost of moving one cell along an axis
+const int STRAIGHT_COST = 10;
+// Cost of moving one cell diagonally, approximating STRAIGHT_COST * sqrt(2)
+const int DIAGONAL_COST = 14;
+
+// The heuristics that can be used to estimate the distance to the end cell
+enum HeuristicType
+{
+	// Exact distance on an open Moore neighbourhood grid; the default
+	HEURISTIC_OCTILE,
+	// Straight line distance, scaled so it never exceeds the octile distance; admissible but underestimates more than octile
+	HEURISTIC_EUCLIDEAN,
+	// Sum of the axis distances; overestimates diagonal moves, so paths may not be optimal
+	HEURISTIC_MANHATTAN,
+	// Largest axis distance; admissible but treats diagonal steps as free
+	HEURISTIC_CHEBYSHEV,
+	HEURISTIC_COUNT
+};
+
+// Estimate the cost of travelling the given distance along each axis
+int EstimateDistance(HeuristicType type, int differenceX, int differenceY);
+
+// Get whether a heuristic never overestimates, so searches using it keep their bounds on path length
+bool IsHeuristicAdmissible(HeuristicType type);
+
+// Get a readable name for a heuristic
+const char* GetHeuristicName(HeuristicType type);
+
+#endif
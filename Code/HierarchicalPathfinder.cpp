@@ -0,0 +1,834 @@
+// HierarchicalPathfinder.cpp
+
+#include "HierarchicalPathfinder.h"
+#include "Heuristic.h"
+#include <algorithm>
+#include <functional>
+#include <limits.h>
+#include <queue>
+#include <stdlib.h>
+#include <unordered_map>
+
+// Runs of open border cells shorter than this get a single entrance in the middle, longer runs get one at each end
+const int MAX_SINGLE_ENTRANCE_WIDTH = 6;
+
+// Cost used for cells that haven't been reached
+const int UNREACHED = INT_MAX;
+
+HierarchicalPathfinder::HierarchicalPathfinder(Grid* grid, int clusterSize)
+{
+
+	this->grid = grid;
+	this->clusterSize = clusterSize;
+
+	// Clusters along the right and bottom edges may be smaller than the rest
+	clustersX = (grid->GetWidth() + clusterSize - 1) / clusterSize;
+	clustersY = (grid->GetHeight() + clusterSize - 1) / clusterSize;
+
+	clusters.resize(clustersX * clustersY);
+	entrances.resize(clustersX * clustersY * BORDER_COUNT);
+
+	for (int clusterY = 0; clusterY < clustersY; clusterY++)
+	{
+
+		for (int clusterX = 0; clusterX < clustersX; clusterX++)
+		{
+
+			Cluster& cluster = clusters[GetClusterAt(clusterX, clusterY)];
+
+			cluster.minX = clusterX * clusterSize;
+			cluster.minY = clusterY * clusterSize;
+			cluster.maxX = std::min(cluster.minX + clusterSize, grid->GetWidth()) - 1;
+			cluster.maxY = std::min(cluster.minY + clusterSize, grid->GetHeight()) - 1;
+
+		}
+
+	}
+
+	localDistances.resize(clusterSize * clusterSize);
+	localParents.resize(clusterSize * clusterSize);
+
+	Build();
+
+}
+
+HierarchicalPathfinder::~HierarchicalPathfinder()
+{
+
+	grid = NULL;
+
+}
+
+// Build the whole abstract graph from the grid's current obstacles
+void HierarchicalPathfinder::Build()
+{
+
+	// Every entrance needs to be known before any cluster can work out its entrance cells
+	for (int cluster = 0; cluster < (int)clusters.size(); cluster++)
+	{
+
+		for (int border = 0; border < BORDER_COUNT; border++)
+		{
+
+			BuildEntrances(cluster, border);
+
+		}
+
+	}
+
+	for (int cluster = 0; cluster < (int)clusters.size(); cluster++)
+	{
+
+		BuildCluster(cluster);
+
+	}
+
+}
+
+// Rebuild only the clusters affected by a change to a cell's obstacle state
+void HierarchicalPathfinder::UpdateCell(int index)
+{
+
+	int clusterX = grid->GetX(index) / clusterSize;
+	int clusterY = grid->GetY(index) / clusterSize;
+	int cluster = GetClusterAt(clusterX, clusterY);
+
+	// The cell can only affect entrances on the borders around its own cluster, some of which are owned by its neighbours
+	for (int border = 0; border < BORDER_COUNT; border++)
+	{
+
+		BuildEntrances(cluster, border);
+
+	}
+
+	if (GetClusterAt(clusterX - 1, clusterY) != -1)
+	{
+
+		BuildEntrances(GetClusterAt(clusterX - 1, clusterY), BORDER_RIGHT);
+
+	}
+
+	if (GetClusterAt(clusterX, clusterY - 1) != -1)
+	{
+
+		BuildEntrances(GetClusterAt(clusterX, clusterY - 1), BORDER_DOWN);
+
+	}
+
+	if (GetClusterAt(clusterX - 1, clusterY - 1) != -1)
+	{
+
+		BuildEntrances(GetClusterAt(clusterX - 1, clusterY - 1), BORDER_DOWN_RIGHT);
+
+	}
+
+	if (GetClusterAt(clusterX + 1, clusterY - 1) != -1)
+	{
+
+		BuildEntrances(GetClusterAt(clusterX + 1, clusterY - 1), BORDER_DOWN_LEFT);
+
+	}
+
+	// The entrance cells of the cluster and all of its neighbours may have changed
+	for (int offsetY = -1; offsetY <= 1; offsetY++)
+	{
+
+		for (int offsetX = -1; offsetX <= 1; offsetX++)
+		{
+
+			int neighbour = GetClusterAt(clusterX + offsetX, clusterY + offsetY);
+
+			if (neighbour != -1)
+			{
+
+				BuildCluster(neighbour);
+
+			}
+
+		}
+
+	}
+
+}
+
+// Find a path by searching the abstract graph and then refining every segment
+bool HierarchicalPathfinder::FindPath(int start, int end, std::vector<int>* path)
+{
+
+	path->clear();
+
+	std::vector<int> waypoints;
+
+	if (!FindAbstractPath(start, end, &waypoints))
+	{
+
+		return false;
+
+	}
+
+	path->push_back(start);
+
+	for (int i = 1; i < (int)waypoints.size(); i++)
+	{
+
+		if (!RefineSegment(waypoints[i - 1], waypoints[i], path))
+		{
+
+			path->clear();
+			return false;
+
+		}
+
+	}
+
+	return true;
+
+}
+
+// Find the abstract path by inserting the start and end cells into the abstract graph and running A* over it
+bool HierarchicalPathfinder::FindAbstractPath(int start, int end, std::vector<int>* waypoints)
+{
+
+	waypoints->clear();
+
+	if (grid->IsObstacle(start) || grid->IsObstacle(end))
+	{
+
+		return false;
+
+	}
+
+	if (start == end)
+	{
+
+		waypoints->push_back(start);
+		return true;
+
+	}
+
+	int startCluster = GetCluster(start);
+	int endCluster = GetCluster(end);
+
+	// Connect the start cell to the entrance cells of its cluster, and to the end cell if they share a cluster
+	std::vector<Edge> startEdges;
+
+	SearchCluster(startCluster, start, -1);
+
+	for (int node : clusters[startCluster].nodes)
+	{
+
+		int distance = localDistances[GetLocalIndex(startCluster, node)];
+
+		if (node != start && distance != UNREACHED)
+		{
+
+			Edge edge = { node, distance };
+			startEdges.push_back(edge);
+
+		}
+
+	}
+
+	if (startCluster == endCluster && localDistances[GetLocalIndex(startCluster, end)] != UNREACHED)
+	{
+
+		Edge edge = { end, localDistances[GetLocalIndex(startCluster, end)] };
+		startEdges.push_back(edge);
+
+	}
+
+	// Connect the entrance cells of the end cell's cluster to the end cell
+	std::unordered_map<int, int> endCosts;
+
+	SearchCluster(endCluster, end, -1);
+
+	for (int node : clusters[endCluster].nodes)
+	{
+
+		int distance = localDistances[GetLocalIndex(endCluster, node)];
+
+		if (distance != UNREACHED)
+		{
+
+			endCosts[node] = distance;
+
+		}
+
+	}
+
+	// Search state for each cell reached in the abstract graph
+	struct AbstractNode
+	{
+		int gCost;
+		int parent;
+		bool isClosed;
+	};
+
+	std::unordered_map<int, AbstractNode> searchNodes;
+	std::priority_queue<std::pair<int, int>, std::vector<std::pair<int, int> >, std::greater<std::pair<int, int> > > openSet;
+
+	int endX = grid->GetX(end);
+	int endY = grid->GetY(end);
+
+	AbstractNode startNode = { 0, -1, false };
+	searchNodes[start] = startNode;
+	openSet.push(std::make_pair(EstimateDistance(HEURISTIC_OCTILE, endX - grid->GetX(start), endY - grid->GetY(start)), start));
+
+	std::vector<Edge> edges;
+
+	while (!openSet.empty())
+	{
+
+		int current = openSet.top().second;
+		openSet.pop();
+
+		// Cells can be pushed more than once as their costs improve, so skip any stale entries
+		if (searchNodes[current].isClosed)
+		{
+
+			continue;
+
+		}
+
+		searchNodes[current].isClosed = true;
+
+		if (current == end)
+		{
+
+			for (int index = end; index != -1; index = searchNodes[index].parent)
+			{
+
+				waypoints->push_back(index);
+
+			}
+
+			std::reverse(waypoints->begin(), waypoints->end());
+
+			return true;
+
+		}
+
+		// Gather the edges leading out of this cell
+		edges.clear();
+
+		if (current == start)
+		{
+
+			edges.insert(edges.end(), startEdges.begin(), startEdges.end());
+
+		}
+
+		int currentCluster = GetCluster(current);
+		int node = FindNode(currentCluster, current);
+
+		if (node != -1)
+		{
+
+			edges.insert(edges.end(), clusters[currentCluster].edges[node].begin(), clusters[currentCluster].edges[node].end());
+
+		}
+
+		if (currentCluster == endCluster && endCosts.count(current) > 0)
+		{
+
+			Edge edge = { end, endCosts[current] };
+			edges.push_back(edge);
+
+		}
+
+		int currentGCost = searchNodes[current].gCost;
+
+		for (const Edge& edge : edges)
+		{
+
+			int newGCost = currentGCost + edge.cost;
+			std::unordered_map<int, AbstractNode>::iterator it = searchNodes.find(edge.target);
+
+			// Edge costs are true distances, so the octile heuristic is consistent and closed cells never need reopening
+			if (it != searchNodes.end() && (it->second.isClosed || newGCost >= it->second.gCost))
+			{
+
+				continue;
+
+			}
+
+			AbstractNode abstractNode = { newGCost, current, false };
+			searchNodes[edge.target] = abstractNode;
+
+			int hCost = EstimateDistance(HEURISTIC_OCTILE, endX - grid->GetX(edge.target), endY - grid->GetY(edge.target));
+			openSet.push(std::make_pair(newGCost + hCost, edge.target));
+
+		}
+
+	}
+
+	return false;
+
+}
+
+// Refine one segment of an abstract path into individual cells
+bool HierarchicalPathfinder::RefineSegment(int from, int to, std::vector<int>* path)
+{
+
+	int cluster = GetCluster(from);
+
+	// Segments between clusters always join neighbouring cells
+	if (GetCluster(to) != cluster)
+	{
+
+		path->push_back(to);
+		return true;
+
+	}
+
+	SearchCluster(cluster, from, to);
+
+	if (localDistances[GetLocalIndex(cluster, to)] == UNREACHED)
+	{
+
+		return false;
+
+	}
+
+	// Trace back from the last cell, then flip the new cells into order
+	int first = (int)path->size();
+
+	for (int local = GetLocalIndex(cluster, to); GetCellIndex(cluster, local) != from; local = localParents[local])
+	{
+
+		path->push_back(GetCellIndex(cluster, local));
+
+	}
+
+	std::reverse(path->begin() + first, path->end());
+
+	return true;
+
+}
+
+// Get the number of entrance cells in the abstract graph
+int HierarchicalPathfinder::GetAbstractNodeCount()
+{
+
+	int count = 0;
+
+	for (Cluster& cluster : clusters)
+	{
+
+		count += (int)cluster.nodes.size();
+
+	}
+
+	return count;
+
+}
+
+// Get the cluster at a position in the cluster grid
+int HierarchicalPathfinder::GetClusterAt(int clusterX, int clusterY)
+{
+
+	if (clusterX < 0 || clusterY < 0 || clusterX >= clustersX || clusterY >= clustersY)
+	{
+
+		return -1;
+
+	}
+
+	return (clusterY * clustersX) + clusterX;
+
+}
+
+// Find the entrances along one of the borders owned by a cluster
+void HierarchicalPathfinder::BuildEntrances(int cluster, int border)
+{
+
+	entrances[(cluster * BORDER_COUNT) + border].clear();
+
+	Cluster& bounds = clusters[cluster];
+	int clusterX = cluster % clustersX;
+	int clusterY = cluster / clustersX;
+
+	// Corners only have a single diagonal crossing
+	if (border == BORDER_DOWN_RIGHT)
+	{
+
+		if (GetClusterAt(clusterX + 1, clusterY + 1) != -1 && grid->IsPassable(bounds.maxX, bounds.maxY) && grid->IsPassable(bounds.maxX + 1, bounds.maxY + 1))
+		{
+
+			AddEntrance(cluster, border, grid->GetIndex(bounds.maxX, bounds.maxY), grid->GetIndex(bounds.maxX + 1, bounds.maxY + 1));
+
+		}
+
+		return;
+
+	}
+
+	if (border == BORDER_DOWN_LEFT)
+	{
+
+		if (GetClusterAt(clusterX - 1, clusterY + 1) != -1 && grid->IsPassable(bounds.minX, bounds.maxY) && grid->IsPassable(bounds.minX - 1, bounds.maxY + 1))
+		{
+
+			AddEntrance(cluster, border, grid->GetIndex(bounds.minX, bounds.maxY), grid->GetIndex(bounds.minX - 1, bounds.maxY + 1));
+
+		}
+
+		return;
+
+	}
+
+	if ((border == BORDER_RIGHT && GetClusterAt(clusterX + 1, clusterY) == -1) || (border == BORDER_DOWN && GetClusterAt(clusterX, clusterY + 1) == -1))
+	{
+
+		return;
+
+	}
+
+	// Walk along the inside edge of the border, crossing over it in the across direction
+	int acrossX = border == BORDER_RIGHT ? 1 : 0;
+	int acrossY = 1 - acrossX;
+	int alongX = acrossY;
+	int alongY = acrossX;
+	int originX = border == BORDER_RIGHT ? bounds.maxX : bounds.minX;
+	int originY = border == BORDER_RIGHT ? bounds.minY : bounds.maxY;
+	int length = border == BORDER_RIGHT ? bounds.maxY - bounds.minY + 1 : bounds.maxX - bounds.minX + 1;
+
+	// Find which positions along the border can be crossed straight over
+	std::vector<bool> isCrossing(length);
+
+	for (int i = 0; i < length; i++)
+	{
+
+		int x = originX + (alongX * i);
+		int y = originY + (alongY * i);
+
+		isCrossing[i] = grid->IsPassable(x, y) && grid->IsPassable(x + acrossX, y + acrossY);
+
+	}
+
+	// Each run of straight crossings gets one entrance in the middle, or two at its ends if it's wide
+	int runStart = -1;
+
+	for (int i = 0; i <= length; i++)
+	{
+
+		bool isOpen = i < length && isCrossing[i];
+
+		if (isOpen && runStart == -1)
+		{
+
+			runStart = i;
+
+		}
+		else if (!isOpen && runStart != -1)
+		{
+
+			int runEnd = i - 1;
+			int positions[2] = { (runStart + runEnd) / 2, -1 };
+
+			if (runEnd - runStart + 1 >= MAX_SINGLE_ENTRANCE_WIDTH)
+			{
+
+				positions[0] = runStart;
+				positions[1] = runEnd;
+
+			}
+
+			for (int position : positions)
+			{
+
+				if (position != -1)
+				{
+
+					int x = originX + (alongX * position);
+					int y = originY + (alongY * position);
+
+					AddEntrance(cluster, border, grid->GetIndex(x, y), grid->GetIndex(x + acrossX, y + acrossY));
+
+				}
+
+			}
+
+			runStart = -1;
+
+		}
+
+	}
+
+	// Diagonal crossings only need their own entrance when neither cell is next to a straight crossing
+	// Otherwise both cells can already reach one of the straight crossings without leaving their clusters
+	for (int i = 0; i + 1 < length; i++)
+	{
+
+		if (isCrossing[i] || isCrossing[i + 1])
+		{
+
+			continue;
+
+		}
+
+		for (int side = 0; side < 2; side++)
+		{
+
+			int insideX = originX + (alongX * (i + side));
+			int insideY = originY + (alongY * (i + side));
+			int outsideX = originX + (alongX * (i + 1 - side)) + acrossX;
+			int outsideY = originY + (alongY * (i + 1 - side)) + acrossY;
+
+			if (grid->IsPassable(insideX, insideY) && grid->IsPassable(outsideX, outsideY))
+			{
+
+				AddEntrance(cluster, border, grid->GetIndex(insideX, insideY), grid->GetIndex(outsideX, outsideY));
+
+			}
+
+		}
+
+	}
+
+}
+
+// Add an entrance to the list for a border
+void HierarchicalPathfinder::AddEntrance(int cluster, int border, int inside, int outside)
+{
+
+	Entrance entrance = { inside, outside };
+
+	entrances[(cluster * BORDER_COUNT) + border].push_back(entrance);
+
+}
+
+// Rebuild the entrance cells of a cluster and the edges between them
+void HierarchicalPathfinder::BuildCluster(int cluster)
+{
+
+	Cluster& bounds = clusters[cluster];
+
+	std::vector<Entrance> clusterEntrances;
+	FindClusterEntrances(cluster, &clusterEntrances);
+
+	bounds.nodes.clear();
+
+	for (const Entrance& entrance : clusterEntrances)
+	{
+
+		if (FindNode(cluster, entrance.inside) == -1)
+		{
+
+			bounds.nodes.push_back(entrance.inside);
+
+		}
+
+	}
+
+	bounds.edges.assign(bounds.nodes.size(), std::vector<Edge>());
+
+	// Edges crossing the border into neighbouring clusters
+	for (const Entrance& entrance : clusterEntrances)
+	{
+
+		bool isDiagonal = grid->GetX(entrance.inside) != grid->GetX(entrance.outside) && grid->GetY(entrance.inside) != grid->GetY(entrance.outside);
+
+		Edge edge = { entrance.outside, isDiagonal ? DIAGONAL_COST : STRAIGHT_COST };
+		bounds.edges[FindNode(cluster, entrance.inside)].push_back(edge);
+
+	}
+
+	// Edges between entrance cells through the inside of the cluster
+	for (int i = 0; i < (int)bounds.nodes.size(); i++)
+	{
+
+		SearchCluster(cluster, bounds.nodes[i], -1);
+
+		for (int j = 0; j < (int)bounds.nodes.size(); j++)
+		{
+
+			int distance = localDistances[GetLocalIndex(cluster, bounds.nodes[j])];
+
+			if (i != j && distance != UNREACHED)
+			{
+
+				Edge edge = { bounds.nodes[j], distance };
+				bounds.edges[i].push_back(edge);
+
+			}
+
+		}
+
+	}
+
+}
+
+// Collect every entrance that has one side inside a cluster, oriented so the inside cell comes first
+void HierarchicalPathfinder::FindClusterEntrances(int cluster, std::vector<Entrance>* clusterEntrances)
+{
+
+	clusterEntrances->clear();
+
+	// Borders owned by the cluster itself
+	for (int border = 0; border < BORDER_COUNT; border++)
+	{
+
+		std::vector<Entrance>& borderEntrances = entrances[(cluster * BORDER_COUNT) + border];
+
+		clusterEntrances->insert(clusterEntrances->end(), borderEntrances.begin(), borderEntrances.end());
+
+	}
+
+	// Borders owned by the neighbours above and to the left, which see this cluster as the outside
+	int clusterX = cluster % clustersX;
+	int clusterY = cluster / clustersX;
+
+	int owners[BORDER_COUNT] =
+	{
+		GetClusterAt(clusterX - 1, clusterY),
+		GetClusterAt(clusterX, clusterY - 1),
+		GetClusterAt(clusterX - 1, clusterY - 1),
+		GetClusterAt(clusterX + 1, clusterY - 1)
+	};
+
+	for (int border = 0; border < BORDER_COUNT; border++)
+	{
+
+		if (owners[border] == -1)
+		{
+
+			continue;
+
+		}
+
+		for (const Entrance& entrance : entrances[(owners[border] * BORDER_COUNT) + border])
+		{
+
+			Entrance flipped = { entrance.outside, entrance.inside };
+			clusterEntrances->push_back(flipped);
+
+		}
+
+	}
+
+}
+
+// Find the position of an entrance cell within its cluster's node list
+int HierarchicalPathfinder::FindNode(int cluster, int index)
+{
+
+	std::vector<int>& nodes = clusters[cluster].nodes;
+
+	for (int i = 0; i < (int)nodes.size(); i++)
+	{
+
+		if (nodes[i] == index)
+		{
+
+			return i;
+
+		}
+
+	}
+
+	return -1;
+
+}
+
+// Run Dijkstra's algorithm from a cell, confined to its cluster
+void HierarchicalPathfinder::SearchCluster(int cluster, int source, int target)
+{
+
+	Cluster& bounds = clusters[cluster];
+
+	std::fill(localDistances.begin(), localDistances.end(), UNREACHED);
+	std::fill(localParents.begin(), localParents.end(), -1);
+
+	std::priority_queue<std::pair<int, int>, std::vector<std::pair<int, int> >, std::greater<std::pair<int, int> > > openSet;
+
+	localDistances[GetLocalIndex(cluster, source)] = 0;
+	openSet.push(std::make_pair(0, GetLocalIndex(cluster, source)));
+
+	while (!openSet.empty())
+	{
+
+		int distance = openSet.top().first;
+		int local = openSet.top().second;
+		openSet.pop();
+
+		// Skip stale entries for cells that have since been reached more cheaply
+		if (distance > localDistances[local])
+		{
+
+			continue;
+
+		}
+
+		int index = GetCellIndex(cluster, local);
+
+		if (index == target)
+		{
+
+			return;
+
+		}
+
+		int x = grid->GetX(index);
+		int y = grid->GetY(index);
+
+		for (const Direction& direction : DIRECTIONS)
+		{
+
+			int neighbourX = x + direction.x;
+			int neighbourY = y + direction.y;
+
+			// Stay inside the cluster
+			if (neighbourX < bounds.minX || neighbourX > bounds.maxX || neighbourY < bounds.minY || neighbourY > bounds.maxY)
+			{
+
+				continue;
+
+			}
+
+			int neighbour = grid->GetIndex(neighbourX, neighbourY);
+
+			if (grid->IsObstacle(neighbour))
+			{
+
+				continue;
+
+			}
+
+			int neighbourLocal = GetLocalIndex(cluster, neighbour);
+			int newDistance = distance + direction.cost;
+
+			if (newDistance < localDistances[neighbourLocal])
+			{
+
+				localDistances[neighbourLocal] = newDistance;
+				localParents[neighbourLocal] = local;
+				openSet.push(std::make_pair(newDistance, neighbourLocal));
+
+			}
+
+		}
+
+	}
+
+}
+
+// Convert a grid cell index to a position within a cluster
+int HierarchicalPathfinder::GetLocalIndex(int cluster, int index)
+{
+
+	Cluster& bounds = clusters[cluster];
+
+	return ((grid->GetY(index) - bounds.minY) * clusterSize) + (grid->GetX(index) - bounds.minX);
+
+}
+
+// Convert a position within a cluster to a grid cell index
+int HierarchicalPathfinder::GetCellIndex(int cluster, int localIndex)
+{
+
+	Cluster& bounds = clusters[cluster];
+
+	return grid->GetIndex(bounds.minX + (localIndex % clusterSize), bounds.minY + (localIndex / clusterSize));
+
+}
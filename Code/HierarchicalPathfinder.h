@@ -0,0 +1,115 @@
+// HierarchicalPathfinder class - HPA* search over a Grid
+// Splits the grid into square clusters and precomputes the entrances between neighbouring clusters and the distances between entrances within each cluster
+// Queries search this small abstract graph first and then refine each segment with a search confined to a single cluster
+// Paths are usually within a few percent of optimal, but aren't guaranteed to be the shortest
+
+#ifndef _HIERARCHICALPATHFINDER_H_
+#define _HIERARCHICALPATHFINDER_H_
+
+#include <vector>
+#include "Grid.h"
+
+class HierarchicalPathfinder
+{
+
+public:
+
+	// Constructor - pass in the grid to search over and the width and height of each cluster in cells
+	HierarchicalPathfinder(Grid* grid, int clusterSize);
+	~HierarchicalPathfinder();
+
+	// Build the whole abstract graph from the grid's current obstacles
+	void Build();
+	// Rebuild only the clusters affected by a change to a cell's obstacle state
+	void UpdateCell(int index);
+
+	// Find a path by searching the abstract graph and then refining every segment
+	// Returns true and fills in the path (start to end, one cell at a time) if one was found
+	bool FindPath(int start, int end, std::vector<int>* path);
+	// Find the abstract path (start cell, the entrance cells passed through, end cell) without refining it
+	bool FindAbstractPath(int start, int end, std::vector<int>* waypoints);
+	// Refine one segment of an abstract path, appending every cell after the first up to and including the last
+	bool RefineSegment(int from, int to, std::vector<int>* path);
+
+	int GetClusterSize() { return clusterSize; }
+	// Get the number of entrance cells in the abstract graph
+	int GetAbstractNodeCount();
+
+private:
+
+	// A weighted edge in the abstract graph, leading to another entrance cell
+	struct Edge
+	{
+		int target;
+		int cost;
+	};
+
+	// A pair of neighbouring cells on either side of a cluster border
+	struct Entrance
+	{
+		int inside;
+		int outside;
+	};
+
+	// A rectangle of cells along with the entrance cells within it and their outgoing edges
+	struct Cluster
+	{
+		int minX;
+		int minY;
+		int maxX;
+		int maxY;
+		std::vector<int> nodes;
+		std::vector<std::vector<Edge> > edges;
+	};
+
+	// The borders each cluster is responsible for finding entrances along
+	enum Border
+	{
+		BORDER_RIGHT,
+		BORDER_DOWN,
+		BORDER_DOWN_RIGHT,
+		BORDER_DOWN_LEFT,
+		BORDER_COUNT
+	};
+
+	// Get the cluster a cell belongs to
+	int GetCluster(int x, int y) { return ((y / clusterSize) * clustersX) + (x / clusterSize); }
+	int GetCluster(int index) { return GetCluster(grid->GetX(index), grid->GetY(index)); }
+	// Get the cluster at a position in the cluster grid, -1 if it's outside
+	int GetClusterAt(int clusterX, int clusterY);
+
+	// Find the entrances along one of the borders owned by a cluster
+	void BuildEntrances(int cluster, int border);
+	// Add an entrance to the list for a border
+	void AddEntrance(int cluster, int border, int inside, int outside);
+	// Rebuild the entrance cells of a cluster and the edges between them
+	void BuildCluster(int cluster);
+	// Collect every entrance that has one side inside a cluster, oriented so the inside cell comes first
+	void FindClusterEntrances(int cluster, std::vector<Entrance>* clusterEntrances);
+	// Find the position of an entrance cell within its cluster's node list, -1 if it isn't an entrance
+	int FindNode(int cluster, int index);
+
+	// Run Dijkstra's algorithm from a cell, confined to its cluster, stopping early if the target is reached
+	// Results are left in localDistances and localParents, indexed by position within the cluster
+	void SearchCluster(int cluster, int source, int target);
+	// Convert between grid cell indices and positions within a cluster
+	int GetLocalIndex(int cluster, int index);
+	int GetCellIndex(int cluster, int localIndex);
+
+	Grid* grid;
+
+	int clusterSize;
+	int clustersX;
+	int clustersY;
+
+	std::vector<Cluster> clusters;
+	// Entrances found along each border, indexed by (cluster * BORDER_COUNT) + border
+	std::vector<std::vector<Entrance> > entrances;
+
+	// Scratch space for searches within a single cluster
+	std::vector<int> localDistances;
+	std::vector<int> localParents;
+
+};
+
+#endif
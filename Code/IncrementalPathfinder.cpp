@@ -0,0 +1,423 @@
+// IncrementalPathfinder.cpp
+
+#include "IncrementalPathfinder.h"
+#include "Heuristic.h"
+#include <algorithm>
+#include <limits.h>
+#include <stdlib.h>
+
+// Cost used for cells that can't reach the end cell; small enough that adding to it can't overflow
+const int INFINITE_COST = INT_MAX / 4;
+
+IncrementalPathfinder::IncrementalPathfinder(Grid* grid) : gCosts(grid->GetCellCount(), INFINITE_COST), rhsCosts(grid->GetCellCount(), INFINITE_COST), openSet(grid->GetCellCount())
+{
+
+	this->grid = grid;
+
+	startIndex = -1;
+	endIndex = -1;
+	lastStartIndex = -1;
+	keyModifier = 0;
+	expansionCount = 0;
+
+}
+
+IncrementalPathfinder::~IncrementalPathfinder()
+{
+
+	grid = NULL;
+
+}
+
+// Start planning from the start cell to the end cell, seeding the open set with the end cell
+void IncrementalPathfinder::Begin(int start, int end)
+{
+
+	startIndex = start;
+	endIndex = end;
+	lastStartIndex = start;
+	keyModifier = 0;
+	expansionCount = 0;
+
+	gCosts.Release();
+	rhsCosts.Release();
+	openSet.Clear();
+
+	// An end cell that's an obstacle can't be reached, so nothing is seeded until it's cleared
+	UpdateRhs(endIndex);
+	UpdateVertex(endIndex);
+
+}
+
+// Stop planning
+void IncrementalPathfinder::Reset()
+{
+
+	startIndex = -1;
+	endIndex = -1;
+	lastStartIndex = -1;
+
+	openSet.Clear();
+
+}
+
+// Expand inconsistent cells until the start cell's cost is known to be correct
+bool IncrementalPathfinder::ComputePath()
+{
+
+	if (!IsActive())
+	{
+
+		return false;
+
+	}
+
+	int startPrimary = 0;
+	int startSecondary = 0;
+	CalculateKey(startIndex, &startPrimary, &startSecondary);
+
+	while (!openSet.IsEmpty())
+	{
+
+		// The secondary key is stored negated, as the open set breaks ties towards the higher value
+		int topPrimary = openSet.TopFCost();
+		int topSecondary = -openSet.TopGCost();
+
+		bool isTopBeforeStart = topPrimary < startPrimary || (topPrimary == startPrimary && topSecondary < startSecondary);
+
+		// Stop once nothing left in the open set could lower the start cell's cost, and the start cell itself is consistent
+		if (!isTopBeforeStart && rhsCosts[startIndex] == gCosts[startIndex])
+		{
+
+			break;
+
+		}
+
+		int current = openSet.Top();
+		int newPrimary = 0;
+		int newSecondary = 0;
+		CalculateKey(current, &newPrimary, &newSecondary);
+
+		expansionCount++;
+
+		unsigned int neighbours = grid->GetInBoundsMask(grid->GetX(current), grid->GetY(current));
+
+		if (topPrimary < newPrimary || (topPrimary == newPrimary && topSecondary < newSecondary))
+		{
+
+			// The key is out of date because the start cell has moved, so requeue it
+			openSet.Update(current, newPrimary, -newSecondary);
+
+		}
+		else if (gCosts[current] > rhsCosts[current])
+		{
+
+			// Overconsistent: the cell has got cheaper, so lock in its new cost and pass it on to its neighbours
+			gCosts[current] = rhsCosts[current];
+			openSet.Remove(current);
+
+			for (int i = 0; i < DIRECTION_COUNT; i++)
+			{
+
+				if ((neighbours & (1u << i)) == 0)
+				{
+
+					continue;
+
+				}
+
+				int neighbour = current + grid->GetNeighbourOffset(i);
+
+				if (neighbour != endIndex)
+				{
+
+					rhsCosts[neighbour] = std::min(rhsCosts[neighbour], GetStepCost(neighbour, current, i) + gCosts[current]);
+					UpdateVertex(neighbour);
+
+				}
+
+			}
+
+		}
+		else
+		{
+
+			// Underconsistent: the cell has got more expensive, so reset it and re-derive it and its neighbours from scratch
+			gCosts[current] = INFINITE_COST;
+
+			UpdateRhs(current);
+			UpdateVertex(current);
+
+			for (int i = 0; i < DIRECTION_COUNT; i++)
+			{
+
+				if ((neighbours & (1u << i)) != 0)
+				{
+
+					int neighbour = current + grid->GetNeighbourOffset(i);
+
+					UpdateRhs(neighbour);
+					UpdateVertex(neighbour);
+
+				}
+
+			}
+
+		}
+
+		CalculateKey(startIndex, &startPrimary, &startSecondary);
+
+	}
+
+	return gCosts[startIndex] < INFINITE_COST;
+
+}
+
+// Tell the pathfinder a cell's obstacle state has changed
+// Every edge into or out of the cell changes cost, so the cell and all of its neighbours need their rhs values updated
+void IncrementalPathfinder::UpdateCell(int index)
+{
+
+	if (!IsActive())
+	{
+
+		return;
+
+	}
+
+	unsigned int neighbours = grid->GetInBoundsMask(grid->GetX(index), grid->GetY(index));
+
+	UpdateRhs(index);
+	UpdateVertex(index);
+
+	for (int i = 0; i < DIRECTION_COUNT; i++)
+	{
+
+		if ((neighbours & (1u << i)) != 0)
+		{
+
+			int neighbour = index + grid->GetNeighbourOffset(i);
+
+			UpdateRhs(neighbour);
+			UpdateVertex(neighbour);
+
+		}
+
+	}
+
+}
+
+// Move the start cell, raising the key modifier so that keys already in the open set remain lower bounds
+void IncrementalPathfinder::MoveStart(int start)
+{
+
+	startIndex = start;
+
+	if (IsActive())
+	{
+
+		keyModifier += EstimateDistance(HEURISTIC_OCTILE, grid->GetX(start) - grid->GetX(lastStartIndex), grid->GetY(start) - grid->GetY(lastStartIndex));
+		lastStartIndex = start;
+
+	}
+
+}
+
+// Follow the computed costs downhill from the start cell to the end cell
+bool IncrementalPathfinder::GetPath(std::vector<int>* path)
+{
+
+	path->clear();
+
+	if (!IsActive() || gCosts[startIndex] >= INFINITE_COST)
+	{
+
+		return false;
+
+	}
+
+	int current = startIndex;
+	path->push_back(current);
+
+	while (current != endIndex)
+	{
+
+		unsigned int neighbours = grid->GetInBoundsMask(grid->GetX(current), grid->GetY(current));
+		int next = -1;
+		int nextCost = INFINITE_COST;
+
+		// Move to whichever neighbour gives the cheapest route to the end cell
+		for (int i = 0; i < DIRECTION_COUNT; i++)
+		{
+
+			if ((neighbours & (1u << i)) == 0)
+			{
+
+				continue;
+
+			}
+
+			int neighbour = current + grid->GetNeighbourOffset(i);
+			int cost = GetStepCost(current, neighbour, i) + gCosts[neighbour];
+
+			if (cost < nextCost)
+			{
+
+				next = neighbour;
+				nextCost = cost;
+
+			}
+
+		}
+
+		// Stop if the costs don't lead anywhere, e.g. because ComputePath hasn't been called since an edit
+		if (next == -1 || (int)path->size() > grid->GetCellCount())
+		{
+
+			path->clear();
+			return false;
+
+		}
+
+		path->push_back(next);
+		current = next;
+
+	}
+
+	return true;
+
+}
+
+// Get the cost of the path from the start cell
+int IncrementalPathfinder::GetPathCost()
+{
+
+	if (!IsActive() || gCosts[startIndex] >= INFINITE_COST)
+	{
+
+		return -1;
+
+	}
+
+	return gCosts[startIndex];
+
+}
+
+// Get the cost of moving between two neighbouring cells
+int IncrementalPathfinder::GetStepCost(int indexA, int indexB, int direction)
+{
+
+	if (grid->IsObstacle(indexA) || grid->IsObstacle(indexB))
+	{
+
+		return INFINITE_COST;
+
+	}
+
+	// Straight and diagonal steps cost the same either way round, so the direction from either cell gives the cost
+	return DIRECTIONS[direction].cost;
+
+}
+
+// Estimate the distance from the start cell to a cell
+int IncrementalPathfinder::Heuristic(int index)
+{
+
+	return EstimateDistance(HEURISTIC_OCTILE, grid->GetX(index) - grid->GetX(startIndex), grid->GetY(index) - grid->GetY(startIndex));
+
+}
+
+// Work out a cell's priority in the open set; cells are ordered by the primary key, then by the secondary key
+void IncrementalPathfinder::CalculateKey(int index, int* primary, int* secondary)
+{
+
+	int cost = std::min(gCosts[index], rhsCosts[index]);
+
+	if (cost >= INFINITE_COST)
+	{
+
+		*primary = INFINITE_COST;
+		*secondary = INFINITE_COST;
+		return;
+
+	}
+
+	*primary = cost + Heuristic(index) + keyModifier;
+	*secondary = cost;
+
+}
+
+// Recalculate a cell's rhs value from its neighbours
+// Obstacles are cut off from their neighbours by infinite step costs, so an obstacle start cell can never reach the end cell
+void IncrementalPathfinder::UpdateRhs(int index)
+{
+
+	// The end cell costs nothing to reach unless it's an obstacle, in which case nothing can reach it
+	if (index == endIndex)
+	{
+
+		rhsCosts[index] = grid->IsObstacle(index) ? INFINITE_COST : 0;
+
+		return;
+
+	}
+
+	unsigned int neighbours = grid->GetInBoundsMask(grid->GetX(index), grid->GetY(index));
+	int rhs = INFINITE_COST;
+
+	for (int i = 0; i < DIRECTION_COUNT; i++)
+	{
+
+		if ((neighbours & (1u << i)) != 0)
+		{
+
+			int neighbour = index + grid->GetNeighbourOffset(i);
+
+			rhs = std::min(rhs, GetStepCost(index, neighbour, i) + gCosts[neighbour]);
+
+		}
+
+	}
+
+	rhsCosts[index] = std::min(rhs, INFINITE_COST);
+
+}
+
+// Add, move or remove a cell in the open set depending on whether it's consistent
+void IncrementalPathfinder::UpdateVertex(int index)
+{
+
+	bool isConsistent = gCosts[index] == rhsCosts[index];
+
+	if (isConsistent)
+	{
+
+		if (openSet.Contains(index))
+		{
+
+			openSet.Remove(index);
+
+		}
+
+		return;
+
+	}
+
+	int primary = 0;
+	int secondary = 0;
+	CalculateKey(index, &primary, &secondary);
+
+	if (openSet.Contains(index))
+	{
+
+		openSet.Update(index, primary, -secondary);
+
+	}
+	else
+	{
+
+		openSet.Push(index, primary, -secondary);
+
+	}
+
+}
@@ -0,0 +1,81 @@
+// IncrementalPathfinder class - D* Lite search that repairs its previous result when obstacles change
+// Searches backwards from the end cell, so the g-cost of every cell is its distance to the end
+// After cells are edited, only the part of the search tree that the edit affects is recomputed
+// The start cell can also be moved along the path (as an agent walks it) without throwing away earlier work
+
+#ifndef _INCREMENTALPATHFINDER_H_
+#define _INCREMENTALPATHFINDER_H_
+
+#include <vector>
+#include "Grid.h"
+#include "OpenSet.h"
+#include "PagedArray.h"
+
+class IncrementalPathfinder
+{
+
+public:
+
+	// Constructor - pass in the grid to search over
+	IncrementalPathfinder(Grid* grid);
+	~IncrementalPathfinder();
+
+	// Start planning from the start cell to the end cell, clearing any previous search
+	// There's no path while either cell is an obstacle; clearing it with UpdateCell lets ComputePath find one
+	void Begin(int start, int end);
+	// Stop planning; edits are ignored until Begin is called again
+	void Reset();
+	// Compute (or repair) the shortest path, returning true if the start cell can reach the end cell
+	bool ComputePath();
+	// Tell the pathfinder a cell's obstacle state has changed; call ComputePath afterwards to repair the path
+	void UpdateCell(int index);
+	// Move the start cell, e.g. as an agent follows the path, keeping the existing search
+	void MoveStart(int start);
+
+	// Follow the computed costs from the start cell to get the path (start to end), if there is one
+	bool GetPath(std::vector<int>* path);
+	// Get the cost of the path from the start cell, -1 if there isn't one
+	int GetPathCost();
+
+	bool IsActive() { return endIndex != -1; }
+	int GetStartIndex() { return startIndex; }
+	int GetEndIndex() { return endIndex; }
+	// Get the number of cells expanded since Begin was called
+	int GetExpansionCount() { return expansionCount; }
+
+private:
+
+	// Get the cost of moving between two neighbouring cells, or INFINITE_COST if either is an obstacle
+	// The direction is the index into DIRECTIONS of the step from one cell to the other
+	int GetStepCost(int indexA, int indexB, int direction);
+	// Estimate the distance from the start cell to a cell
+	int Heuristic(int index);
+	// Work out a cell's priority in the open set
+	void CalculateKey(int index, int* primary, int* secondary);
+	// Recalculate a cell's rhs value (one-step lookahead cost) from its neighbours
+	void UpdateRhs(int index);
+	// Add, move or remove a cell in the open set depending on whether it's consistent
+	void UpdateVertex(int index);
+
+	Grid* grid;
+
+	// Distance from each cell to the end cell as of its last expansion
+	PagedArray<int> gCosts;
+	// One-step lookahead of each cell's distance to the end cell, based on its neighbours' g-costs
+	// Both are paged, so planning over a huge grid only allocates the area around the cells it reaches
+	PagedArray<int> rhsCosts;
+	// Cells whose g-cost and rhs value disagree
+	OpenSet openSet;
+
+	int startIndex;
+	int endIndex;
+	// The start cell when the heuristic offset was last updated
+	int lastStartIndex;
+	// Offset added to every key so old keys stay valid after the start cell moves
+	int keyModifier;
+
+	int expansionCount;
+
+};
+
+#endif
@@ -0,0 +1,150 @@
+// JumpPointTable.cpp
+
+#include "JumpPointTable.h"
+#include <limits.h>
+#include <stddef.h>
+
+JumpPointTable::JumpPointTable()
+{
+
+	builtGrid = NULL;
+	builtVersion = 0;
+
+}
+
+JumpPointTable::~JumpPointTable()
+{
+
+	builtGrid = NULL;
+
+}
+
+// Precompute the jump distances for every cell in the grid
+bool JumpPointTable::Build(Grid* grid)
+{
+
+	// A distance along a longer side could wrap around and send JPS+ the wrong way
+	if (grid->GetWidth() > SHRT_MAX || grid->GetHeight() > SHRT_MAX)
+	{
+
+		distances.clear();
+		builtGrid = NULL;
+
+		return false;
+
+	}
+
+	distances.assign(grid->GetCellCount() * DIRECTION_COUNT, 0);
+
+	// Diagonal distances depend on the straight ones, which come first in DIRECTIONS
+	for (int direction = 0; direction < DIRECTION_COUNT; direction++)
+	{
+
+		BuildDirection(grid, direction);
+
+	}
+
+	builtGrid = grid;
+	builtVersion = grid->GetVersion();
+
+	return true;
+
+}
+
+// A straight move stops where a blocked side cell opens up diagonally ahead
+bool JumpPointTable::HasStraightForcedNeighbour(Grid* grid, int x, int y, const Direction& direction)
+{
+
+	if (direction.x != 0)
+	{
+
+		return (grid->IsPassable(x + direction.x, y + 1) && !grid->IsPassable(x, y + 1)) ||
+			(grid->IsPassable(x + direction.x, y - 1) && !grid->IsPassable(x, y - 1));
+
+	}
+
+	return (grid->IsPassable(x + 1, y + direction.y) && !grid->IsPassable(x + 1, y)) ||
+		(grid->IsPassable(x - 1, y + direction.y) && !grid->IsPassable(x - 1, y));
+
+}
+
+// A diagonal move stops where a blocked cell behind it opens up
+bool JumpPointTable::HasDiagonalForcedNeighbour(Grid* grid, int x, int y, const Direction& direction)
+{
+
+	return (grid->IsPassable(x - direction.x, y + direction.y) && !grid->IsPassable(x - direction.x, y)) ||
+		(grid->IsPassable(x + direction.x, y - direction.y) && !grid->IsPassable(x, y - direction.y));
+
+}
+
+// Fill in the distances for one direction
+// Cells are visited against the direction of travel, so the next cell along has always been filled in already
+void JumpPointTable::BuildDirection(Grid* grid, int direction)
+{
+
+	const Direction& step = DIRECTIONS[direction];
+	int width = grid->GetWidth();
+	int height = grid->GetHeight();
+
+	// Indices of the straight directions that make up a diagonal one
+	int directionX = GetDirectionIndex(step.x, 0);
+	int directionY = GetDirectionIndex(0, step.y);
+
+	for (int i = 0; i < height; i++)
+	{
+
+		int y = step.y > 0 ? height - 1 - i : i;
+
+		for (int j = 0; j < width; j++)
+		{
+
+			int x = step.x > 0 ? width - 1 - j : j;
+			int nextX = x + step.x;
+			int nextY = y + step.y;
+			int distance = 0;
+
+			if (grid->IsPassable(nextX, nextY))
+			{
+
+				int next = grid->GetIndex(nextX, nextY);
+				bool isJumpPoint = false;
+
+				if (step.x == 0 || step.y == 0)
+				{
+
+					isJumpPoint = HasStraightForcedNeighbour(grid, nextX, nextY, step);
+
+				}
+				else
+				{
+
+					// Diagonal moves also stop wherever one of their straight components would find a jump point
+					isJumpPoint = HasDiagonalForcedNeighbour(grid, nextX, nextY, step) ||
+						GetDistance(next, directionX) > 0 || GetDistance(next, directionY) > 0;
+
+				}
+
+				if (isJumpPoint)
+				{
+
+					distance = 1;
+
+				}
+				else
+				{
+
+					// Carry on from the next cell's distance, one step further away
+					int nextDistance = GetDistance(next, direction);
+					distance = nextDistance > 0 ? nextDistance + 1 : nextDistance - 1;
+
+				}
+
+			}
+
+			distances[(grid->GetIndex(x, y) * DIRECTION_COUNT) + direction] = (short)distance;
+
+		}
+
+	}
+
+}
@@ -0,0 +1,47 @@
+// JumpPointTable class - precomputed jump distances used by JPS+
+// For every cell and direction, stores how far a jump point search would travel before finding a jump point or hitting a wall
+// Positive distances are the number of steps to the next jump point, zero or negative distances are the number of steps before a wall
+
+#ifndef _JUMPPOINTTABLE_H_
+#define _JUMPPOINTTABLE_H_
+
+#include <vector>
+#include "Grid.h"
+
+class JumpPointTable
+{
+
+public:
+
+	JumpPointTable();
+	~JumpPointTable();
+
+	// Precompute the jump distances for every cell in the grid
+	// Returns false, leaving the table unbuilt, if a side of the grid is too long for its distances to be stored
+	bool Build(Grid* grid);
+	// Get whether the table matches the current obstacles in the grid
+	bool IsBuiltFor(Grid* grid) { return grid == builtGrid && grid->GetVersion() == builtVersion; }
+
+	// Get the jump distance from a cell in one of the DIRECTIONS
+	int GetDistance(int index, int direction) { return distances[(index * DIRECTION_COUNT) + direction]; }
+
+private:
+
+	// Get whether a straight move in a direction would stop at a cell because it has a forced neighbour
+	bool HasStraightForcedNeighbour(Grid* grid, int x, int y, const Direction& direction);
+	// Get whether a diagonal move in a direction would stop at a cell because it has a forced neighbour
+	bool HasDiagonalForcedNeighbour(Grid* grid, int x, int y, const Direction& direction);
+	// Fill in the distances for one direction, working backwards from the far edge of the grid
+	void BuildDirection(Grid* grid, int direction);
+
+	// Distances are never longer than a side of the grid, so they're stored as 16 bits to halve the table on large maps
+	// This limits JPS+ to grids up to SHRT_MAX (32767) cells along each side
+	std::vector<short> distances;
+
+	// The grid and grid version the table was last built for
+	Grid* builtGrid;
+	int builtVersion;
+
+};
+
+#endif
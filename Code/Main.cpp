@@ -1,238 +1,458 @@
 // Basic C++ application demonstrating the A* pathfinding algorithm in a two dimensional grid
-// Uses Moore neighbourhood and Euclidean distances for pathfinding
-// Works step-by-step, showing the algorithm progressing towards the end goal
-// Uses SFML's graphics library to do window handling, sprite and text rendering
+// Run with no arguments for a 32x18 grid, with a width and height for a blank grid of that size, or with a map file to load
+// Uses Moore neighbourhood and octile distances for pathfinding
+// Works step-by-step, showing the algorithm progressing towards the end goal, or within a fixed time budget per frame
+// Uses SFML's graphics library to do window handling and to render the grid from batched vertex arrays
 // SFML (Simple and Fast Multimedia Library) - Copyright (c) Laurent Gomila
 // Available at: https://www.sfml-dev.org/index.php
 
-#include <chrono>
-#include <thread>
+#include <algorithm>
+#include <fstream>
+#include <stdio.h>
+#include <stdlib.h>
 #include <SFML/Graphics.hpp>
-#include "Tile.h"
-
-// Simple rounding function used to find the tile that mouse clicks happen within
-int RoundDown(int i, int n)
+#include "AgentSimulation.h"
+#include "GridRenderer.h"
+#include "Grid.h"
+#include "Pathfinder.h"
+#include "ConnectedComponents.h"
+#include "FlowField.h"
+#include "HierarchicalPathfinder.h"
+#include "IncrementalPathfinder.h"
+#include "MapFile.h"
+#include "SearchStats.h"
+
+// How the search moves on each frame while R is held down
+enum SearchPacing
+{
+	// One cell at a time, with a pause between each so the search can be followed
+	PACING_STEP,
+	// As many cells as fit within a fixed time budget each frame, as a game would run a long search
+	PACING_BUDGET,
+	// Straight through to the end in one frame
+	PACING_COMPLETE,
+	PACING_COUNT
+};
+
+// Get a readable name for a search pacing
+const char* GetPacingName(SearchPacing pacing)
 {
-	return (i / n) * n;
+
+	switch (pacing)
+	{
+
+	case PACING_STEP:
+		return "step";
+
+	case PACING_BUDGET:
+		return "budgeted";
+
+	case PACING_COMPLETE:
+		return "complete";
+
+	default:
+		return "unknown";
+
+	}
 
 }
 
-// Find the tile with the lowest F-cost
-Tile* findTile(std::vector<Tile*> *openSet, int currentGCost, Tile* endTile)
+// Update the tiles to show the pathfinder's open & closed sets and costs
+// Only the cells the current search has reached need to be visited
+void ShowSearchState(GridRenderer* renderer, Pathfinder* pathfinder)
 {
 
-	int newFCost = openSet->front()->fCost;
-	Tile* tileToReturn = openSet->front();
+	for (int i : pathfinder->GetTouchedCells())
+	{
+
+		if (pathfinder->IsOpen(i))
+		{
+
+			renderer->SetToOpen(i);
+			renderer->SetCosts(i, pathfinder->GetGCost(i), pathfinder->GetFCost(i));
+
+		}
+		else if (pathfinder->IsClosed(i))
+		{
+
+			renderer->SetToClosed(i);
+			renderer->SetCosts(i, pathfinder->GetGCost(i), pathfinder->GetFCost(i));
+
+		}
+
+	}
+
+}
+
+// Replace the last path shown by the incremental pathfinder with its current path
+void ShowReplannedPath(GridRenderer* renderer, Grid* grid, IncrementalPathfinder* incrementalPathfinder, std::vector<int>* replannedPath)
+{
 
-	for (Tile* it : *openSet)
+	for (int index : *replannedPath)
 	{
 
-		if (it->fCost < newFCost)
+		if (!grid->IsObstacle(index))
 		{
 
-			newFCost = it->fCost;
+			renderer->ResetCell(index);
 
-			tileToReturn = it;
+		}
+
+	}
+
+	incrementalPathfinder->GetPath(replannedPath);
+
+	for (int index : *replannedPath)
+	{
+
+		renderer->SetToPath(index);
+
+	}
+
+}
+
+// Replace the last path shown from the flow field with the route it now gives from a start cell
+void ShowFlowPath(GridRenderer* renderer, Grid* grid, FlowField* flowField, int start, std::vector<int>* flowPath)
+{
+
+	for (int index : *flowPath)
+	{
+
+		if (!grid->IsObstacle(index))
+		{
+
+			renderer->ResetCell(index);
 
 		}
 
 	}
 
-	return tileToReturn;
+	flowField->GetPath(start, flowPath);
+
+	for (int index : *flowPath)
+	{
+
+		renderer->SetToPath(index);
+
+	}
 
 }
 
-int main()
+// Describe the current search's counters and phase timers for the on-screen display
+std::string FormatStats(Pathfinder* pathfinder)
 {
 
-	// Initialise the SFML render window to a 16:9 resolution running at 60 FPS
-	sf::RenderWindow window(sf::VideoMode(1600, 900), "Pathfinding Algorithm Application");
-	window.setFramerateLimit(60);
+	SearchStats stats = pathfinder->GetStats();
 
-	// Initialise the font we need for the text displayed on each grid tile
-	sf::Font calibri;
+	std::string text = std::string(GetSearchModeName(pathfinder->GetSearchMode())) + "\n" +
+		"Expanded: " + std::to_string(stats.expansions) + "\n" +
+		"Inserted: " + std::to_string(stats.insertions) + "\n" +
+		"Decrease keys: " + std::to_string(stats.decreaseKeys) + "\n" +
+		"Reopened: " + std::to_string(stats.reopens) + "\n" +
+		"Peak open set: " + std::to_string(stats.peakOpenSetSize) + "\n";
 
-	// Quit the program if the text can't be found - no point running it if we can't see the text
-	if (!calibri.loadFromFile("calibri.ttf"))
+#if PATHFINDER_STATS >= 2
+	text += "Setup: " + std::to_string(stats.setupNanoseconds / 1000) + " us\n" +
+		"Select: " + std::to_string(stats.selectNanoseconds / 1000) + " us\n" +
+		"Expand: " + std::to_string(stats.expandNanoseconds / 1000) + " us\n" +
+		"Trace: " + std::to_string(stats.traceNanoseconds / 1000) + " us\n";
+#elif PATHFINDER_STATS == 0
+	text += "(counters compiled out)\n";
+#endif
+
+	return text;
+
+}
+
+// Describe the agent simulation for the on-screen display
+std::string FormatAgentStats(AgentSimulation* simulation)
+{
+
+	const SimulationStats& stats = simulation->GetStats();
+	int arrivedCount = 0;
+
+	for (int i = 0; i < simulation->GetAgentCount(); i++)
 	{
 
-		return 0;
+		if (simulation->GetAgent(i).state == AGENT_ARRIVED)
+		{
+
+			arrivedCount++;
+
+		}
 
 	}
 
-	int mode = 0; // Default mode, obstacle placement mode = 1
+	long long tickMicroseconds = stats.ticks > 0 ? (stats.pathNanoseconds + stats.moveNanoseconds) / 1000 / stats.ticks : 0;
 
-	// Initialise the tiles
-	const int GRID_DIMS_X = 32;
-	const int GRID_DIMS_Y = 18;
-	const float TILE_OFFSET = 50.0f;
-	int tileOffset = TILE_OFFSET;
-	int tileOffsetX = 0;
-	int tileOffsetY = 0;
+	return "\nAgents: " + std::to_string(simulation->GetAgentCount()) + " (" + std::to_string(arrivedCount) + " arrived)\n" +
+		"Path requests: " + std::to_string(stats.pathRequests) + " (" + std::to_string(stats.cacheHits) + " cached)\n" +
+		"Tick: " + std::to_string(tickMicroseconds) + " us\n";
 
-	Tile* tileGrid[GRID_DIMS_X * GRID_DIMS_Y];
+}
 
-	for (int y = 0; y < GRID_DIMS_Y; y++)
+// Add agents on random empty cells, all heading for a goal cell if one is given, or each for a random passable cell otherwise
+void SpawnAgents(AgentSimulation* simulation, Grid* grid, int count, int goal)
+{
+
+	std::vector<int> passableCells;
+
+	for (int i = 0; i < grid->GetCellCount(); i++)
 	{
 
-		for (int x = 0; x < GRID_DIMS_X; x++)
+		if (!grid->IsObstacle(i) && simulation->GetAgentAt(i) == -1)
 		{
 
-			tileGrid[(GRID_DIMS_X * y) + x] = new Tile(x * TILE_OFFSET, y * TILE_OFFSET, &calibri, TILE_OFFSET - 1.0f);
+			passableCells.push_back(i);
 
 		}
 
 	}
 
-	// Set the tile neighbours
-	for (int y = 0; y < GRID_DIMS_Y; y++)
+	// rand() can be as small as 15 bits, so two calls are combined to reach every cell of a large grid
+	for (int i = 0; i < count && !passableCells.empty(); i++)
+	{
+
+		int slot = (int)((((long long)rand() << 15) ^ rand()) % passableCells.size());
+		int agentGoal = goal != -1 ? goal : passableCells[(((long long)rand() << 15) ^ rand()) % passableCells.size()];
+
+		simulation->AddAgent(passableCells[slot], agentGoal);
+
+		passableCells[slot] = passableCells.back();
+		passableCells.pop_back();
+
+	}
+
+}
+
+// Write the stats of every search finished so far to search_stats.csv and search_stats.json
+void ExportStats(const std::vector<std::string>& labels, const std::vector<SearchStats>& history)
+{
+
+	std::ofstream csvFile("search_stats.csv");
+	std::ofstream jsonFile("search_stats.json");
+
+	WriteSearchStatsCsvHeader(csvFile);
+	jsonFile << "[\n";
+
+	for (size_t i = 0; i < history.size(); i++)
+	{
+
+		WriteSearchStatsCsv(csvFile, labels[i].c_str(), history[i]);
+
+		jsonFile << (i == 0 ? "  " : ",\n  ");
+		WriteSearchStatsJson(jsonFile, labels[i].c_str(), history[i]);
+
+	}
+
+	jsonFile << "\n]\n";
+
+}
+
+// Format a heuristic weight or suboptimality bound to two decimal places
+std::string FormatWeight(double weight)
+{
+
+	char text[16];
+	snprintf(text, sizeof(text), "%.2f", weight);
+
+	return text;
+
+}
+
+// Show the current search mode, heuristic and pacing in the window title, along with the cells expanded once a search has finished
+void UpdateTitle(sf::RenderWindow* window, Pathfinder* pathfinder, SearchPacing pacing)
+{
+
+	std::string title = std::string("Pathfinding Algorithm Application - ") + GetSearchModeName(pathfinder->GetSearchMode()) +
+		" (" + GetHeuristicName(pathfinder->GetHeuristic()) + ", " + GetPacingName(pacing) + ")";
+
+	if (pathfinder->GetSearchMode() == SEARCH_MODE_WEIGHTED_ASTAR || pathfinder->GetSearchMode() == SEARCH_MODE_ANYTIME)
+	{
+
+		title += " - weight " + FormatWeight(pathfinder->GetHeuristicWeight());
+
+	}
+
+	if (pathfinder->GetStatus() == SEARCH_FOUND || pathfinder->GetStatus() == SEARCH_FAILED)
 	{
 
-		for (int x = 0; x < GRID_DIMS_X; x++)
+		title += " - " + std::to_string(pathfinder->GetExpansionCount()) + " cells expanded";
+
+	}
+
+	// Anytime searches have a path while they're still running; show how far from the shortest path it could be
+	// A heuristic that overestimates gives no such bound
+	if (pathfinder->GetSolutionCount() > 0)
+	{
+
+		title += " - path cost " + std::to_string(pathfinder->GetPathCost());
+
+		if (IsHeuristicAdmissible(pathfinder->GetHeuristic()))
 		{
 
-			// Top left corner
-			if (x == 0 && y == 0)
-			{
+			title += ", at most " + FormatWeight(pathfinder->GetSuboptimalityBound()) + " times the shortest";
 
-				tileGrid[(GRID_DIMS_X * y) + x]->SetNeighbours(NULL,
-					tileGrid[(GRID_DIMS_X * y) + x + 1],
-					NULL,
-					tileGrid[(GRID_DIMS_X * (y + 1)) + x]);
-				tileGrid[(GRID_DIMS_X * y) + x]->SetCornerNeighbours(NULL,
-					NULL,
-					NULL,
-					tileGrid[(GRID_DIMS_X * (y + 1)) + x + 1]);
+		}
+		else
+		{
 
-			}
-			// Bottom right corner
-			else if (x == GRID_DIMS_X - 1 && y == GRID_DIMS_Y - 1)
-			{
+			title += ", unbounded";
 
-				tileGrid[(GRID_DIMS_X * y) + x]->SetNeighbours(tileGrid[(GRID_DIMS_X * y) + x - 1],
-					NULL,
-					tileGrid[(GRID_DIMS_X * (y - 1)) + x],
-					NULL);
-				tileGrid[(GRID_DIMS_X * y) + x]->SetCornerNeighbours(tileGrid[(GRID_DIMS_X * (y - 1)) + x - 1],
-					NULL,
-					NULL,
-					NULL);
+		}
 
-			}
-			// Bottom left corner
-			else if (x == 0 && y == GRID_DIMS_Y - 1)
-			{
+	}
 
-				tileGrid[(GRID_DIMS_X * y) + x]->SetNeighbours(NULL,
-					tileGrid[(GRID_DIMS_X * y) + x + 1],
-					tileGrid[(GRID_DIMS_X * (y - 1)) + x],
-					NULL);
-				tileGrid[(GRID_DIMS_X * y) + x]->SetCornerNeighbours(NULL,
-					tileGrid[(GRID_DIMS_X * (y - 1)) + x + 1],
-					NULL,
-					NULL);
+	window->setTitle(title);
 
-			}
-			// Top right corner
-			else if (x == GRID_DIMS_X - 1 && y == 0)
-			{
+}
+
+int main(int argc, char** argv)
+{
 
-				tileGrid[(GRID_DIMS_X * y) + x]->SetNeighbours(tileGrid[(GRID_DIMS_X * y) + x - 1],
-					NULL,
-					NULL,
-					tileGrid[(GRID_DIMS_X * (y + 1)) + x]);
-				tileGrid[(GRID_DIMS_X * y) + x]->SetCornerNeighbours(NULL,
-					NULL,
-					tileGrid[(GRID_DIMS_X * (y + 1)) + x - 1],
-					NULL);
+	// Initialise the SFML render window to a 16:9 resolution running at 60 FPS
+	sf::RenderWindow window(sf::VideoMode(1600, 900), "Pathfinding Algorithm Application");
+	window.setFramerateLimit(60);
 
-			}
-			// Top edge
-			else if (y == 0)
-			{
+	// Initialise the font we need for the text displayed on each grid tile
+	sf::Font calibri;
 
-				tileGrid[(GRID_DIMS_X * y) + x]->SetNeighbours(tileGrid[(GRID_DIMS_X * y) + x - 1],
-					tileGrid[(GRID_DIMS_X * y) + x + 1],
-					NULL,
-					tileGrid[(GRID_DIMS_X * (y + 1)) + x]);
-				tileGrid[(GRID_DIMS_X * y) + x]->SetCornerNeighbours(NULL,
-					NULL,
-					tileGrid[(GRID_DIMS_X * (y + 1)) + x - 1],
-					tileGrid[(GRID_DIMS_X * (y + 1)) + x + 1]);
+	// Quit the program if the text can't be found - no point running it if we can't see the text
+	if (!calibri.loadFromFile("calibri.ttf"))
+	{
 
-			}
-			// Bottom edge
-			else if (y == GRID_DIMS_Y - 1)
-			{
+		return 0;
 
-				tileGrid[(GRID_DIMS_X * y) + x]->SetNeighbours(tileGrid[(GRID_DIMS_X * y) + x - 1],
-					tileGrid[(GRID_DIMS_X * y) + x + 1],
-					tileGrid[(GRID_DIMS_X * (y - 1)) + x],
-					NULL);
-				tileGrid[(GRID_DIMS_X * y) + x]->SetCornerNeighbours(tileGrid[(GRID_DIMS_X * (y - 1)) + x - 1],
-					tileGrid[(GRID_DIMS_X * (y - 1)) + x + 1],
-					NULL,
-					NULL);
+	}
 
-			}
-			// Left edge
-			else if (x == 0)
-			{
+	int mode = 0; // Default mode, obstacle placement mode = 1
 
-				tileGrid[(GRID_DIMS_X * y) + x]->SetNeighbours(NULL,
-					tileGrid[(GRID_DIMS_X * y) + x + 1],
-					tileGrid[(GRID_DIMS_X * (y - 1)) + x],
-					tileGrid[(GRID_DIMS_X * (y + 1)) + x]);
-				tileGrid[(GRID_DIMS_X * y) + x]->SetCornerNeighbours(NULL,
-					tileGrid[(GRID_DIMS_X * (y - 1)) + x + 1],
-					NULL,
-					tileGrid[(GRID_DIMS_X * (y + 1)) + x + 1]);
+	// Work out the grid size from the command line, loading the map file if one was given
+	int gridWidth = 32;
+	int gridHeight = 18;
+	Grid* loadedGrid = NULL;
 
-			}
-			// Right edge
-			else if (x == GRID_DIMS_X - 1)
-			{
+	if (argc == 2)
+	{
 
-				tileGrid[(GRID_DIMS_X * y) + x]->SetNeighbours(tileGrid[(GRID_DIMS_X * y) + x - 1],
-					NULL,
-					tileGrid[(GRID_DIMS_X * (y - 1)) + x],
-					tileGrid[(GRID_DIMS_X * (y + 1)) + x]);
-				tileGrid[(GRID_DIMS_X * y) + x]->SetCornerNeighbours(tileGrid[(GRID_DIMS_X * (y - 1)) + x - 1],
-					NULL,
-					tileGrid[(GRID_DIMS_X * (y + 1)) + x - 1],
-					NULL);
+		loadedGrid = LoadMap(argv[1]);
 
-			}
-			else
+		if (loadedGrid == NULL)
+		{
+
+			return 0;
+
+		}
+
+		gridWidth = loadedGrid->GetWidth();
+		gridHeight = loadedGrid->GetHeight();
+
+	}
+	else if (argc >= 3)
+	{
+
+		gridWidth = std::max(1, atoi(argv[1]));
+		gridHeight = std::max(1, atoi(argv[2]));
+
+	}
+
+	// Initialise the grid renderer
+	const float TILE_OFFSET = 50.0f;
+
+	GridRenderer renderer(gridWidth, gridHeight, TILE_OFFSET, &calibri);
+
+	// Camera over the grid; WASD pans it and the scroll wheel zooms it, so the grid itself never moves
+	sf::View camera = window.getDefaultView();
+	float cameraZoom = 1.0f;
+	const float PAN_SPEED = 5.0f;
+	const float ZOOM_STEP = 1.1f;
+	const float MIN_ZOOM = 0.25f;
+	const float MAX_ZOOM = 16.0f;
+
+	// Create the headless grid and pathfinder that the renderer displays
+	Grid grid(gridWidth, gridHeight);
+	Pathfinder pathfinder(&grid);
+
+	// Region labels, updated as obstacles are painted so the pathfinder can reject unreachable end tiles without searching
+	ConnectedComponents components;
+	pathfinder.SetComponents(&components);
+
+	if (loadedGrid != NULL)
+	{
+
+		for (int i = 0; i < grid.GetCellCount(); i++)
+		{
+
+			if (loadedGrid->IsObstacle(i))
 			{
 
-				tileGrid[(GRID_DIMS_X * y) + x]->SetNeighbours(tileGrid[(GRID_DIMS_X * y) + x - 1],
-					tileGrid[(GRID_DIMS_X * y) + x + 1],
-					tileGrid[(GRID_DIMS_X * (y - 1)) + x],
-					tileGrid[(GRID_DIMS_X * (y + 1)) + x]);
-				tileGrid[(GRID_DIMS_X * y) + x]->SetCornerNeighbours(tileGrid[(GRID_DIMS_X * (y - 1)) + x - 1],
-					tileGrid[(GRID_DIMS_X * (y - 1)) + x + 1],
-					tileGrid[(GRID_DIMS_X * (y + 1)) + x - 1],
-					tileGrid[(GRID_DIMS_X * (y + 1)) + x + 1]);
+				grid.SetObstacle(i, true);
+				renderer.SetObstacle(i);
 
 			}
 
 		}
 
+		delete loadedGrid;
+		loadedGrid = NULL;
+
 	}
 
+	// Hierarchical pathfinder, created the first time it's used and then kept up to date with obstacle edits
+	// Building the hierarchy for a large map takes a while, so it isn't done up front
+	const int CLUSTER_SIZE = 8;
+	HierarchicalPathfinder* hierarchicalPathfinder = NULL;
+
+	// Incremental (D* Lite) pathfinder, which repairs its path as obstacles are edited once it's been started
+	IncrementalPathfinder incrementalPathfinder(&grid);
+	std::vector<int> replannedPath;
+
+	// Flow field towards a single goal, which is repaired as obstacles are edited once it's been built
+	FlowField flowField(&grid);
+	std::vector<int> flowPath;
+	int flowStart = -1;
+
+	// Agents heading for goals across the grid, added with G and moved on a step every tick interval
+	// Path requests from every agent in a tick are solved in parallel, and repeated ones are answered from the cache
+	const int AGENT_CACHE_CAPACITY = 1024;
+	const int AGENTS_PER_SPAWN = 500;
+	const int AGENT_TICK_MILLISECONDS = 100;
+	const sf::Color AGENT_COLOUR(255, 140, 0);
+	AgentSimulation simulation(&grid, 0, AGENT_CACHE_CAPACITY);
+	sf::Clock agentClock;
+	std::vector<int> agentCells;
+
+	// Search pacing, along with the pause between cells when stepping and the time allowed per frame when budgeted
+	SearchPacing pacing = PACING_STEP;
+	const int STEP_INTERVAL_MILLISECONDS = 100;
+	const int FRAME_BUDGET_MICROSECONDS = 2000;
+	sf::Clock stepClock;
+
+	UpdateTitle(&window, &pathfinder, pacing);
+
 	// Initialise values for start/end tile selection
 	int lastSelectedStartTile = 0;
 	int lastSelectedEndTile = 0;
 
-	// Create the open & closed sets, and the path
-	std::vector<Tile*> openSet;
-	std::vector<Tile*> closedSet;
-
-	bool isRunning = false;
-	bool foundPath = false;
-	int currentGCost = 0;
-	Tile* currentTile = NULL;
+	// The path found by the pathfinder, and the number of paths the current search has found (ARA* finds a shorter one on each pass)
+	std::vector<int> path;
+	int shownSolutionCount = 0;
+
+	// Heuristic weights for weighted A* and ARA* to cycle through, starting at the pathfinder's default of 2
+	const int HEURISTIC_WEIGHT_COUNT = 4;
+	const double HEURISTIC_WEIGHTS[HEURISTIC_WEIGHT_COUNT] = { 2.0, 3.0, 5.0, 1.5 };
+	int weightChoice = 0;
+
+	// On-screen display of the current search's stats, toggled with Tab, along with the stats of every finished search for exporting
+	bool showStats = true;
+	sf::Text statsText("", calibri, 16);
+	statsText.setFillColor(sf::Color(255, 255, 255));
+	statsText.setPosition(18.0f, 14.0f);
+	sf::RectangleShape statsBackground(sf::Vector2f(220.0f, 230.0f));
+	statsBackground.setFillColor(sf::Color(0, 0, 0, 160));
+	statsBackground.setPosition(10.0f, 10.0f);
+	std::vector<std::string> statsLabels;
+	std::vector<SearchStats> statsHistory;
 
 	// Main program loop
 	while (window.isOpen())
@@ -258,40 +478,58 @@ int main()
 
 			}
 
-			// Update tiles here
-			for (int i = 0; i < GRID_DIMS_Y*GRID_DIMS_X; i++)
+			// Show or hide the search stats when Tab is pressed
+			if (event.type == sf::Event::KeyPressed && event.key.code == sf::Keyboard::Tab)
 			{
 
-				tileGrid[i]->Update();
+				showStats = !showStats;
 
 			}
 
-			// Update tile offsets when the grid moves
-			if (sf::Keyboard::isKeyPressed(sf::Keyboard::D))
+			// Export the stats of every finished search when E is pressed
+			if (event.type == sf::Event::KeyPressed && event.key.code == sf::Keyboard::E)
 			{
 
-				tileOffsetX += 1;
+				ExportStats(statsLabels, statsHistory);
 
 			}
 
-			if (sf::Keyboard::isKeyPressed(sf::Keyboard::A))
+			// Add a crowd of agents when G is pressed, all heading for the end tile if one is selected, or for random cells otherwise
+			if (event.type == sf::Event::KeyPressed && event.key.code == sf::Keyboard::G)
 			{
 
-				tileOffsetX -= 1;
+				SpawnAgents(&simulation, &grid, AGENTS_PER_SPAWN, renderer.IsSelected(lastSelectedEndTile) ? lastSelectedEndTile : -1);
+				agentClock.restart();
 
 			}
 
-			if (sf::Keyboard::isKeyPressed(sf::Keyboard::W))
+			// Remove every agent when X is pressed
+			if (event.type == sf::Event::KeyPressed && event.key.code == sf::Keyboard::X)
 			{
 
-				tileOffsetY -= 1;
+				simulation.Clear();
 
 			}
 
-			if (sf::Keyboard::isKeyPressed(sf::Keyboard::S))
+			// Zoom the camera in or out around the mouse with the scroll wheel, keeping the point under the mouse still
+			if (event.type == sf::Event::MouseWheelScrolled)
 			{
 
-				tileOffsetY += 1;
+				float factor = event.mouseWheelScroll.delta > 0 ? 1.0f / ZOOM_STEP : ZOOM_STEP;
+
+				if (cameraZoom * factor >= MIN_ZOOM && cameraZoom * factor <= MAX_ZOOM)
+				{
+
+					sf::Vector2i mousePixel(event.mouseWheelScroll.x, event.mouseWheelScroll.y);
+					sf::Vector2f before = window.mapPixelToCoords(mousePixel, camera);
+
+					camera.zoom(factor);
+					cameraZoom *= factor;
+
+					camera.move(before - window.mapPixelToCoords(mousePixel, camera));
+					window.setView(camera);
+
+				}
 
 			}
 
@@ -305,103 +543,192 @@ int main()
 
 				}
 
+				// Cycle through the heuristics when H is pressed (uses the key event so each press only moves on once)
+				if (event.type == sf::Event::KeyPressed && event.key.code == sf::Keyboard::H)
+				{
+
+					pathfinder.SetHeuristic((HeuristicType)((pathfinder.GetHeuristic() + 1) % HEURISTIC_COUNT));
+
+					UpdateTitle(&window, &pathfinder, pacing);
+
+				}
+
+				// Cycle through the search modes when J is pressed
+				if (event.type == sf::Event::KeyPressed && event.key.code == sf::Keyboard::J)
+				{
+
+					pathfinder.SetSearchMode((SearchMode)((pathfinder.GetSearchMode() + 1) % SEARCH_MODE_COUNT));
+
+					UpdateTitle(&window, &pathfinder, pacing);
+
+				}
+
+				// Cycle through the search pacings (step, budgeted, complete) when T is pressed
+				if (event.type == sf::Event::KeyPressed && event.key.code == sf::Keyboard::T)
+				{
+
+					pacing = (SearchPacing)((pacing + 1) % PACING_COUNT);
+
+					UpdateTitle(&window, &pathfinder, pacing);
+
+				}
+
+				// Cycle through the heuristic weights used by weighted A* and ARA* when K is pressed
+				if (event.type == sf::Event::KeyPressed && event.key.code == sf::Keyboard::K)
+				{
+
+					weightChoice = (weightChoice + 1) % HEURISTIC_WEIGHT_COUNT;
+					pathfinder.SetHeuristicWeight(HEURISTIC_WEIGHTS[weightChoice]);
+
+					UpdateTitle(&window, &pathfinder, pacing);
+
+				}
+
+				// Save the grid as a map file when M is pressed, so it can be run through the benchmark
+				if (event.type == sf::Event::KeyPressed && event.key.code == sf::Keyboard::M)
+				{
+
+					SaveMap(&grid, "grid.map");
+
+				}
+
 				// Select tile when the user clicks on it
 				if (sf::Mouse::isButtonPressed(sf::Mouse::Button::Left))
 				{
 
 					// Deselect the last tile
-					tileGrid[lastSelectedStartTile]->Deselect();
+					renderer.Deselect(lastSelectedStartTile);
+
+					// Find the tile that the button press happened within
+					int i = renderer.GetCellAt(&window, sf::Mouse::getPosition(window));
+
+					if (i != -1 && !grid.IsObstacle(i))
+					{
+
+						// Select the tile
+						renderer.Select(i, sf::Color(0, 255, 0));
 
-					// Get the mouse position and round down
-					// This will be used to find the tile that the button press happened within
-					sf::Vector2i mousePosition = sf::Mouse::getPosition(window);
+						// Update this to be the last selected tile
+						lastSelectedStartTile = i;
 
-					int xRounded = RoundDown(mousePosition.x - tileOffsetX, tileOffset) + tileOffsetX;
-					int yRounded = RoundDown(mousePosition.y - tileOffsetY, tileOffset) + tileOffsetY;
+					}
 
-					// Loop to find the tile (could be done using [])
-					for (int i = 0; i < GRID_DIMS_X * GRID_DIMS_Y; i++)
+				}
+
+				// Select tile when the user clicks on it
+				if (sf::Mouse::isButtonPressed(sf::Mouse::Button::Right))
+				{
+
+					// Deselect the last tile
+					renderer.Deselect(lastSelectedEndTile);
+
+					// Find the tile that the button press happened within
+					int i = renderer.GetCellAt(&window, sf::Mouse::getPosition(window));
+
+					if (i != -1 && !grid.IsObstacle(i))
 					{
 
-						if (tileGrid[i]->GetPosition().x == xRounded && tileGrid[i]->GetPosition().y == yRounded)
-						{
+						// Select the tile
+						renderer.Select(i, sf::Color(255, 0, 0));
 
-							if (!tileGrid[i]->IsObstacle())
-							{
+						// Update this to be the last selected tile
+						lastSelectedEndTile = i;
 
-								// Select the tile
-								tileGrid[i]->Select(sf::Color(0, 255, 0));
+					}
 
-								// Update this to be the last selected tile
-								lastSelectedStartTile = i;
+				}
 
-							}
+				if (sf::Keyboard::isKeyPressed(sf::Keyboard::R))
+				{
+
+					if (renderer.IsSelected(lastSelectedStartTile) && renderer.IsSelected(lastSelectedEndTile))
+					{
+
+						// Run A*, starting with the start tile
+						renderer.Deselect(lastSelectedStartTile);
+
+						// Edits that could split a region leave the labels out of date, so they're relabelled here rather than on every edit
+						if (!components.IsBuiltFor(&grid))
+						{
+
+							components.Build(&grid);
 
 						}
 
+						pathfinder.Begin(lastSelectedStartTile, lastSelectedEndTile);
+						path.clear();
+						shownSolutionCount = 0;
+
+						ShowSearchState(&renderer, &pathfinder);
+
 					}
 
 				}
 
-				// Select tile when the user clicks on it
-				if (sf::Mouse::isButtonPressed(sf::Mouse::Button::Right))
+				// Find a path with HPA* in one go when P is pressed
+				if (event.type == sf::Event::KeyPressed && event.key.code == sf::Keyboard::P)
 				{
 
-					// Deselect the last tile
-					tileGrid[lastSelectedEndTile]->Deselect();
+					if (renderer.IsSelected(lastSelectedStartTile) && renderer.IsSelected(lastSelectedEndTile))
+					{
 
-					// Get the mouse position and round down
-					// This will be used to find the tile that the button press happened within
-					sf::Vector2i mousePosition = sf::Mouse::getPosition(window);
+						if (hierarchicalPathfinder == NULL)
+						{
 
-					int xRounded = RoundDown(mousePosition.x - tileOffsetX, tileOffset) + tileOffsetX;
-					int yRounded = RoundDown(mousePosition.y - tileOffsetY, tileOffset) + tileOffsetY;
+							hierarchicalPathfinder = new HierarchicalPathfinder(&grid, CLUSTER_SIZE);
 
-					// Loop to find the tile (could be done using [])
-					for (int i = 0; i < GRID_DIMS_X * GRID_DIMS_Y; i++)
-					{
+						}
 
-						if (tileGrid[i]->GetPosition().x == xRounded && tileGrid[i]->GetPosition().y == yRounded)
+						if (hierarchicalPathfinder->FindPath(lastSelectedStartTile, lastSelectedEndTile, &path))
 						{
 
-							if (!tileGrid[i]->IsObstacle())
+							for (int index : path)
 							{
 
-								// Select the tile
-								tileGrid[i]->Select(sf::Color(255, 0, 0));
-
-								// Update this to be the last selected tile
-								lastSelectedEndTile = i;
+								renderer.SetToPath(index);
 
 							}
 
 						}
 
+						// Reset simulation values
+						lastSelectedStartTile = 0;
+						lastSelectedEndTile = 0;
+
 					}
 
 				}
 
-				if (sf::Keyboard::isKeyPressed(sf::Keyboard::R))
+				// Start incremental replanning when I is pressed; the path is then repaired after every obstacle edit
+				if (event.type == sf::Event::KeyPressed && event.key.code == sf::Keyboard::I)
 				{
 
-					if (tileGrid[lastSelectedStartTile]->IsSelected() && tileGrid[lastSelectedEndTile]->IsSelected())
+					if (renderer.IsSelected(lastSelectedStartTile) && renderer.IsSelected(lastSelectedEndTile))
 					{
 
-						// Run A*
-						isRunning = true;
+						incrementalPathfinder.Begin(lastSelectedStartTile, lastSelectedEndTile);
+						incrementalPathfinder.ComputePath();
 
-						// Start with the start tile
-						tileGrid[lastSelectedStartTile]->Deselect();
+						replannedPath.clear();
+						ShowReplannedPath(&renderer, &grid, &incrementalPathfinder, &replannedPath);
 
-						tileGrid[lastSelectedStartTile]->CalculateCosts(0, tileGrid[lastSelectedEndTile]);
+					}
 
-						currentGCost = tileGrid[lastSelectedStartTile]->GetGCost();
+				}
 
-						currentTile = tileGrid[lastSelectedStartTile];
+				// Build a flow field to the end tile when F is pressed, showing the route it gives from the start tile
+				// The field is repaired after every obstacle edit, as it would be for a crowd of agents sharing the goal
+				if (event.type == sf::Event::KeyPressed && event.key.code == sf::Keyboard::F)
+				{
 
-						openSet.push_back(currentTile);
+					if (renderer.IsSelected(lastSelectedStartTile) && renderer.IsSelected(lastSelectedEndTile))
+					{
+
+						flowField.Build(lastSelectedEndTile);
+						flowStart = lastSelectedStartTile;
 
-						currentTile->SetToOpen();
+						flowPath.clear();
+						ShowFlowPath(&renderer, &grid, &flowField, flowStart, &flowPath);
 
 					}
 
@@ -410,12 +737,29 @@ int main()
 				if (sf::Keyboard::isKeyPressed(sf::Keyboard::C))
 				{
 
-					for (int i = 0; i < GRID_DIMS_X * GRID_DIMS_Y; i++)
+					for (int i = 0; i < grid.GetCellCount(); i++)
 					{
 
-						
 						// Reset the tile
-						tileGrid[i]->ResetTile();
+						renderer.ResetCell(i);
+
+					}
+
+					incrementalPathfinder.Reset();
+					replannedPath.clear();
+
+					flowField.Reset();
+					flowPath.clear();
+
+					simulation.Clear();
+
+					grid.ClearObstacles();
+					pathfinder.Reset();
+
+					if (hierarchicalPathfinder != NULL)
+					{
+
+						hierarchicalPathfinder->Build();
 
 					}
 
@@ -438,41 +782,101 @@ int main()
 				if (sf::Keyboard::isKeyPressed(sf::Keyboard::C))
 				{
 
-					for (int i = 0; i < GRID_DIMS_X * GRID_DIMS_Y; i++)
+					bool hasCleared = false;
+
+					for (int i = 0; i < grid.GetCellCount(); i++)
 					{
 
-						if (tileGrid[i]->IsObstacle())
+						if (grid.IsObstacle(i))
 						{
 
 							// Reset the tile
-							tileGrid[i]->ResetTile();
+							renderer.ResetCell(i);
+							grid.SetObstacle(i, false);
+							components.UpdateCell(i);
+							incrementalPathfinder.UpdateCell(i);
+							hasCleared = true;
 
 						}
 
 					}
 
+					// Rebuild the hierarchy once rather than cluster by cluster, as a loaded map can have millions of obstacles
+					if (hasCleared && hierarchicalPathfinder != NULL)
+					{
+
+						hierarchicalPathfinder->Build();
+
+					}
+
+					if (incrementalPathfinder.IsActive())
+					{
+
+						incrementalPathfinder.ComputePath();
+						ShowReplannedPath(&renderer, &grid, &incrementalPathfinder, &replannedPath);
+
+					}
+
+					// Clearing every obstacle is cheaper to rebuild from than to repair cell by cell
+					if (hasCleared && flowField.GetGoal() != -1)
+					{
+
+						flowField.Build(flowField.GetGoal());
+						ShowFlowPath(&renderer, &grid, &flowField, flowStart, &flowPath);
+
+					}
+
+					if (hasCleared)
+					{
+
+						simulation.UpdateAllCells();
+
+					}
+
 				}
 
 				// Select tile when the user clicks on it
 				if (sf::Mouse::isButtonPressed(sf::Mouse::Button::Left))
 				{
 
-					// Get the mouse position and round down
-					// This will be used to find the tile that the button press happened within
-					sf::Vector2i mousePosition = sf::Mouse::getPosition(window);
+					// Find the tile that the button press happened within
+					int i = renderer.GetCellAt(&window, sf::Mouse::getPosition(window));
 
-					int xRounded = RoundDown(mousePosition.x - tileOffsetX, tileOffset) + tileOffsetX;
-					int yRounded = RoundDown(mousePosition.y - tileOffsetY, tileOffset) + tileOffsetY;
-
-					// Loop to find the tile (could be done using [])
-					for (int i = 0; i < GRID_DIMS_X * GRID_DIMS_Y; i++)
+					// Only rebuild the affected clusters if this is a new obstacle, as painting revisits the same tiles
+					// Cells with agents standing on them are left alone
+					if (i != -1 && !grid.IsObstacle(i) && simulation.GetAgentAt(i) == -1)
 					{
 
-						if (tileGrid[i]->GetPosition().x == xRounded && tileGrid[i]->GetPosition().y == yRounded)
+						// Select the tile
+						renderer.SetObstacle(i);
+
+						grid.SetObstacle(i, true);
+						components.UpdateCell(i);
+						simulation.UpdateCell(i);
+
+						if (hierarchicalPathfinder != NULL)
 						{
 
-							// Select the tile
-							tileGrid[i]->SetObstacle();
+							hierarchicalPathfinder->UpdateCell(i);
+
+						}
+
+						// Repair the incremental path around the new obstacle
+						if (incrementalPathfinder.IsActive())
+						{
+
+							incrementalPathfinder.UpdateCell(i);
+							incrementalPathfinder.ComputePath();
+							ShowReplannedPath(&renderer, &grid, &incrementalPathfinder, &replannedPath);
+
+						}
+
+						// Repair the flow field around the new obstacle
+						if (flowField.GetGoal() != -1)
+						{
+
+							flowField.UpdateCell(i);
+							ShowFlowPath(&renderer, &grid, &flowField, flowStart, &flowPath);
 
 						}
 
@@ -482,100 +886,210 @@ int main()
 
 			}
 
-			// Running the A* algorithm
-			if (sf::Keyboard::isKeyPressed(sf::Keyboard::R))
+		}
+
+		// Pan the camera with WASD, at the same speed on screen however far it's zoomed
+		if (window.hasFocus())
+		{
+
+			sf::Vector2f pan;
+
+			if (sf::Keyboard::isKeyPressed(sf::Keyboard::D))
+			{
+
+				pan.x -= PAN_SPEED;
+
+			}
+
+			if (sf::Keyboard::isKeyPressed(sf::Keyboard::A))
+			{
+
+				pan.x += PAN_SPEED;
+
+			}
+
+			if (sf::Keyboard::isKeyPressed(sf::Keyboard::W))
+			{
+
+				pan.y += PAN_SPEED;
+
+			}
+
+			if (sf::Keyboard::isKeyPressed(sf::Keyboard::S))
+			{
+
+				pan.y -= PAN_SPEED;
+
+			}
+
+			if (pan.x != 0.0f || pan.y != 0.0f)
+			{
+
+				camera.move(pan * cameraZoom);
+				window.setView(camera);
+
+			}
+
+		}
+
+		// Run the search while R is held down, moving it on as far as the pacing allows this frame
+		if (window.hasFocus() && sf::Keyboard::isKeyPressed(sf::Keyboard::R) && pathfinder.GetStatus() == SEARCH_RUNNING)
+		{
+
+			SearchStatus status = SEARCH_RUNNING;
+
+			if (pacing == PACING_STEP)
+			{
+
+				// Expand the next cell in the open set with the lowest cost, once the pause since the last one is over
+				if (stepClock.getElapsedTime().asMilliseconds() >= STEP_INTERVAL_MILLISECONDS)
+				{
+
+					status = pathfinder.Advance(1, 0);
+					stepClock.restart();
+
+				}
+
+			}
+			else if (pacing == PACING_BUDGET)
+			{
+
+				status = pathfinder.Advance(0, FRAME_BUDGET_MICROSECONDS);
+
+			}
+			else
 			{
-				if (!openSet.empty())
+
+				status = pathfinder.Advance(0, 0);
+
+			}
+
+			// An ARA* pass has found a shorter path; the last one's cells were all expanded by an earlier pass, so they go back to closed
+			if (status == SEARCH_RUNNING && pathfinder.GetSolutionCount() != shownSolutionCount)
+			{
+
+				for (int index : path)
 				{
 
-					// Find the next tile in the open set with the lowest cost
-					currentTile = findTile(&openSet, currentGCost, tileGrid[lastSelectedEndTile]);
+					renderer.SetToClosed(index);
 
-					currentGCost = currentTile->GetGCost();
+				}
 
-					// Check if the current tile is the end tile
-					if (currentTile == tileGrid[lastSelectedEndTile])
-					{
+				pathfinder.GetPath(&path);
+				shownSolutionCount = pathfinder.GetSolutionCount();
 
-						// If it is, we've found the desired path
-						foundPath = true;
+				UpdateTitle(&window, &pathfinder, pacing);
 
-					}
+			}
+
+			ShowSearchState(&renderer, &pathfinder);
 
-					// Search the tile's neighbourhood
-					currentTile->SearchNeighbourhood(currentGCost, tileGrid[lastSelectedEndTile], &openSet, &closedSet);
+			// Keep the best path so far on top of the search state while ARA* carries on improving it
+			if (status == SEARCH_RUNNING && shownSolutionCount > 0)
+			{
 
-					// Remove the current tile from the open set
-					openSet.erase(std::remove(openSet.begin(), openSet.end(), currentTile));
+				for (int index : path)
+				{
 
-					// Add it to the closed set
-					closedSet.push_back(currentTile);
+					renderer.SetToPath(index);
 
-					currentTile->SetToClosed();
+				}
 
-					// Once a path has been found, trace back to find the path
-					while (foundPath)
-					{
+			}
 
-						// Get the end tile and its parent tile
-						tileGrid[lastSelectedEndTile]->SetToPath();
-						Tile* nextTile = tileGrid[lastSelectedEndTile]->GetParentTile();
+			if (status != SEARCH_RUNNING)
+			{
 
-						// Repeat process until the start tile is found
-						while (nextTile != tileGrid[lastSelectedStartTile])
-						{
+				UpdateTitle(&window, &pathfinder, pacing);
 
-							nextTile->SetToPath();
-							nextTile = nextTile->GetParentTile();
+				statsLabels.push_back(GetSearchModeName(pathfinder.GetSearchMode()));
+				statsHistory.push_back(pathfinder.GetStats());
 
-						}
+			}
 
-						// Add the start tile to the path
-						tileGrid[lastSelectedStartTile]->SetToPath();
+			// Once a path has been found, trace back to find the path
+			if (status == SEARCH_FOUND)
+			{
 
-						// Reset simulation values
-						foundPath = false;
-						lastSelectedStartTile = 0;
-						lastSelectedEndTile = 0;
-						currentTile = NULL;
+				for (int index : path)
+				{
 
-						// Clear the vectors
-						openSet.clear();
-						closedSet.clear();
+					renderer.SetToClosed(index);
 
-					}
+				}
 
-					std::this_thread::sleep_for(std::chrono::milliseconds(100));
+				pathfinder.GetPath(&path);
+
+				for (int index : path)
+				{
+
+					renderer.SetToPath(index);
 
 				}
 
+				// Reset simulation values
+				lastSelectedStartTile = 0;
+				lastSelectedEndTile = 0;
+
 			}
 
 		}
 
-		// Render tiles here
+		// Move the agents on a step once the tick interval has passed
+		if (simulation.GetAgentCount() > 0 && agentClock.getElapsedTime().asMilliseconds() >= AGENT_TICK_MILLISECONDS)
+		{
+
+			simulation.Tick();
+			agentClock.restart();
+
+		}
+
+		// Render the grid here
 		window.clear();
 
-		for (int i = 0; i < GRID_DIMS_Y*GRID_DIMS_X; i++)
+		renderer.Render(&window);
+
+		agentCells.clear();
+
+		for (int i = 0; i < simulation.GetAgentCount(); i++)
 		{
 
-			tileGrid[i]->Render(&window);
+			agentCells.push_back(simulation.GetAgent(i).cell);
 
 		}
 
-		window.display();
+		renderer.RenderMarkers(&window, agentCells, AGENT_COLOUR);
 
-	}
+		// The stats are drawn in screen space, so they stay put while the camera moves
+		if (showStats)
+		{
 
-	// Clear the tile objects from memory now the application is finished
-	for (int i = 0; i < GRID_DIMS_X * GRID_DIMS_Y; i++)
-	{
+			std::string text = FormatStats(&pathfinder);
+
+			if (simulation.GetAgentCount() > 0)
+			{
+
+				text += FormatAgentStats(&simulation);
+
+			}
 
-		delete tileGrid[i];
-		tileGrid[i] = NULL;
+			statsText.setString(text);
+			statsBackground.setSize(sf::Vector2f(220.0f, std::max(230.0f, statsText.getLocalBounds().top + statsText.getLocalBounds().height + 20.0f)));
+
+			window.setView(window.getDefaultView());
+			window.draw(statsBackground);
+			window.draw(statsText);
+			window.setView(camera);
+
+		}
+
+		window.display();
 
 	}
 
+	delete hierarchicalPathfinder;
+	hierarchicalPathfinder = NULL;
+
 	return 0;
 
 }
\ No newline at end of file
@@ -0,0 +1,173 @@
+// MapFile.cpp
+
+#include "MapFile.h"
+#include <fstream>
+#include <sstream>
+#include <string>
+
+// Load a map file into a new grid
+Grid* LoadMap(const char* filename)
+{
+
+	std::ifstream file(filename);
+
+	if (!file)
+	{
+
+		return NULL;
+
+	}
+
+	// The header lists the map type and dimensions in any order, ending with the "map" line
+	int width = 0;
+	int height = 0;
+	std::string key;
+
+	while (file >> key && key != "map")
+	{
+
+		if (key == "width")
+		{
+
+			file >> width;
+
+		}
+		else if (key == "height")
+		{
+
+			file >> height;
+
+		}
+		else
+		{
+
+			// Skip the value of any other header line (just "type" in the current format)
+			file >> key;
+
+		}
+
+	}
+
+	if (key != "map" || width <= 0 || height <= 0)
+	{
+
+		return NULL;
+
+	}
+
+	Grid* grid = new Grid(width, height);
+
+	std::string row;
+
+	for (int y = 0; y < height; y++)
+	{
+
+		if (!(file >> row) || (int)row.size() < width)
+		{
+
+			delete grid;
+			return NULL;
+
+		}
+
+		for (int x = 0; x < width; x++)
+		{
+
+			char terrain = row[x];
+
+			if (terrain != '.' && terrain != 'G' && terrain != 'S')
+			{
+
+				grid->SetObstacle(grid->GetIndex(x, y), true);
+
+			}
+
+		}
+
+	}
+
+	return grid;
+
+}
+
+// Save a grid as a map file
+bool SaveMap(Grid* grid, const char* filename)
+{
+
+	std::ofstream file(filename);
+
+	if (!file)
+	{
+
+		return false;
+
+	}
+
+	file << "type octile\nheight " << grid->GetHeight() << "\nwidth " << grid->GetWidth() << "\nmap\n";
+
+	for (int y = 0; y < grid->GetHeight(); y++)
+	{
+
+		std::string row(grid->GetWidth(), '.');
+
+		for (int x = 0; x < grid->GetWidth(); x++)
+		{
+
+			if (grid->IsObstacle(grid->GetIndex(x, y)))
+			{
+
+				row[x] = '@';
+
+			}
+
+		}
+
+		file << row << '\n';
+
+	}
+
+	return (bool)file;
+
+}
+
+// Load the queries from a scenario file
+bool LoadScenario(const char* filename, std::vector<ScenarioQuery>* queries)
+{
+
+	std::ifstream file(filename);
+
+	if (!file)
+	{
+
+		return false;
+
+	}
+
+	queries->clear();
+
+	std::string line;
+
+	while (std::getline(file, line))
+	{
+
+		// Each query line is: bucket, map name, map width, map height, start x, start y, end x, end y, optimal length
+		// Anything else (the version line, blank lines) fails to parse and is skipped
+		std::istringstream stream(line);
+		int bucket = 0;
+		std::string mapName;
+		int mapWidth = 0;
+		int mapHeight = 0;
+		ScenarioQuery query;
+
+		if (stream >> bucket >> mapName >> mapWidth >> mapHeight >> query.startX >> query.startY >> query.endX >> query.endY >> query.optimalLength)
+		{
+
+			queries->push_back(query);
+
+		}
+
+	}
+
+	return true;
+
+}
@@ -0,0 +1,30 @@
+// MapFile functions - reading and writing grids and queries in the Moving AI benchmark formats
+// Maps are text grids with a short header; scenarios list start/end pairs along with the length of their optimal path
+
+#ifndef _MAPFILE_H_
+#define _MAPFILE_H_
+
+#include <vector>
+#include "Grid.h"
+
+// A single query from a scenario file
+struct ScenarioQuery
+{
+	int startX;
+	int startY;
+	int endX;
+	int endY;
+	// Length of the optimal path, counting straight moves as 1 and diagonal moves as the square root of 2
+	double optimalLength;
+};
+
+// Load a map file into a new grid, returning NULL if the file can't be read
+// '.', 'G' and 'S' cells are passable; every other terrain type is treated as an obstacle
+Grid* LoadMap(const char* filename);
+// Save a grid as a map file, so grids edited in the demo can be benchmarked; returns false if the file can't be written
+bool SaveMap(Grid* grid, const char* filename);
+
+// Load the queries from a scenario file, returning false if the file can't be read
+bool LoadScenario(const char* filename, std::vector<ScenarioQuery>* queries);
+
+#endif
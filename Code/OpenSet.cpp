@@ -0,0 +1,215 @@
+// OpenSet.cpp
+
+#include "OpenSet.h"
+
+OpenSet::OpenSet(int cellCount) : positions(cellCount, -1)
+{
+
+}
+
+OpenSet::~OpenSet()
+{
+
+}
+
+// Add a cell to the bottom of the heap and move it up into place
+void OpenSet::Push(int index, int fCost, int gCost)
+{
+
+	Entry entry;
+	entry.index = index;
+	entry.fCost = fCost;
+	entry.gCost = gCost;
+
+	heap.push_back(entry);
+	positions[index] = (int)heap.size() - 1;
+
+	SiftUp((int)heap.size() - 1);
+
+}
+
+// Lower the costs of a cell already in the heap; it can only move towards the root
+void OpenSet::DecreaseKey(int index, int fCost, int gCost)
+{
+
+	int position = positions[index];
+
+	heap[position].fCost = fCost;
+	heap[position].gCost = gCost;
+
+	SiftUp(position);
+
+}
+
+// Change the costs of a cell already in the heap, moving it whichever way it needs to go
+void OpenSet::Update(int index, int fCost, int gCost)
+{
+
+	int position = positions[index];
+
+	heap[position].fCost = fCost;
+	heap[position].gCost = gCost;
+
+	SiftUp(position);
+	SiftDown(positions[index]);
+
+}
+
+// Remove a cell from anywhere in the heap, filling its place with the last entry
+void OpenSet::Remove(int index)
+{
+
+	int position = positions[index];
+	positions[index] = -1;
+
+	Entry last = heap.back();
+	heap.pop_back();
+
+	if (position < (int)heap.size())
+	{
+
+		Place(last, position);
+		SiftUp(position);
+		SiftDown(positions[last.index]);
+
+	}
+
+}
+
+// Remove the root of the heap, replacing it with the last entry
+int OpenSet::Pop()
+{
+
+	int index = heap.front().index;
+	positions[index] = -1;
+
+	Entry last = heap.back();
+	heap.pop_back();
+
+	if (!heap.empty())
+	{
+
+		Place(last, 0);
+		SiftDown(0);
+
+	}
+
+	return index;
+
+}
+
+// Remove every cell from the heap, only touching the cells that were in it
+void OpenSet::Clear()
+{
+
+	for (Entry& entry : heap)
+	{
+
+		positions[entry.index] = -1;
+
+	}
+
+	heap.clear();
+
+}
+
+// Lowest f-cost first; prefer higher g-cost (closer to the end) on ties, then lowest index
+bool OpenSet::IsBefore(const Entry& a, const Entry& b)
+{
+
+	if (a.fCost != b.fCost)
+	{
+
+		return a.fCost < b.fCost;
+
+	}
+
+	if (a.gCost != b.gCost)
+	{
+
+		return a.gCost > b.gCost;
+
+	}
+
+	return a.index < b.index;
+
+}
+
+// Move an entry towards the root until its parent should be expanded before it
+void OpenSet::SiftUp(int position)
+{
+
+	Entry entry = heap[position];
+
+	while (position > 0)
+	{
+
+		int parent = (position - 1) / 2;
+
+		if (!IsBefore(entry, heap[parent]))
+		{
+
+			break;
+
+		}
+
+		Place(heap[parent], position);
+		position = parent;
+
+	}
+
+	Place(entry, position);
+
+}
+
+// Move an entry towards the leaves until it should be expanded before both of its children
+void OpenSet::SiftDown(int position)
+{
+
+	Entry entry = heap[position];
+	int size = (int)heap.size();
+
+	while (true)
+	{
+
+		int child = (position * 2) + 1;
+
+		if (child >= size)
+		{
+
+			break;
+
+		}
+
+		// Pick whichever child should be expanded first
+		if (child + 1 < size && IsBefore(heap[child + 1], heap[child]))
+		{
+
+			child++;
+
+		}
+
+		if (!IsBefore(heap[child], entry))
+		{
+
+			break;
+
+		}
+
+		Place(heap[child], position);
+		position = child;
+
+	}
+
+	Place(entry, position);
+
+}
+
+// Place an entry at a heap position and record where it is
+void OpenSet::Place(const Entry& entry, int position)
+{
+
+	heap[position] = entry;
+	positions[entry.index] = position;
+
+}
@@ -0,0 +1,68 @@
+// OpenSet class - indexed binary heap used as the A* open set
+// Cells are ordered by lowest f-cost, with ties broken by highest g-cost and then lowest cell index so searches are reproducible
+// Keeps the heap position of every cell so costs can be decreased in place
+
+#ifndef _OPENSET_H_
+#define _OPENSET_H_
+
+#include <vector>
+#include "PagedArray.h"
+
+class OpenSet
+{
+
+public:
+
+	// Constructor - pass in the number of cells that could be added
+	OpenSet(int cellCount);
+	~OpenSet();
+
+	bool IsEmpty() { return heap.empty(); }
+	int GetSize() { return (int)heap.size(); }
+	// Get whether a cell is currently in the heap
+	bool Contains(int index) { return positions.Get(index) != -1; }
+
+	// Add a cell to the heap
+	void Push(int index, int fCost, int gCost);
+	// Lower the costs of a cell already in the heap
+	void DecreaseKey(int index, int fCost, int gCost);
+	// Change the costs of a cell already in the heap, in either direction
+	void Update(int index, int fCost, int gCost);
+	// Remove a cell from anywhere in the heap
+	void Remove(int index);
+	// Remove and return the cell with the lowest f-cost
+	int Pop();
+	// Get the cell with the lowest f-cost without removing it
+	int Top() { return heap.front().index; }
+	// Get the costs of the cell at the top of the heap
+	int TopFCost() { return heap.front().fCost; }
+	int TopGCost() { return heap.front().gCost; }
+	// Remove every cell from the heap
+	void Clear();
+
+private:
+
+	// A cell in the heap, along with the costs it's ordered by
+	struct Entry
+	{
+		int index;
+		int fCost;
+		int gCost;
+	};
+
+	// Whether entry a should be expanded before entry b
+	bool IsBefore(const Entry& a, const Entry& b);
+	// Move the entry at a heap position towards the root until the heap is ordered
+	void SiftUp(int position);
+	// Move the entry at a heap position towards the leaves until the heap is ordered
+	void SiftDown(int position);
+	// Place an entry at a heap position and record where it is
+	void Place(const Entry& entry, int position);
+
+	std::vector<Entry> heap;
+	// Heap position of each cell, -1 if the cell isn't in the heap; only pages around cells that have been pushed are allocated
+	PagedArray<int> positions;
+
+};
+
+#endif
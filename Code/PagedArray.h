@@ -0,0 +1,110 @@
+// PagedArray class - fixed-size array whose storage is allocated a page at a time, the first time each page is written
+// Used for per-cell search state, so a search over a huge grid only pays for the parts of the grid it actually reaches
+
+#ifndef _PAGEDARRAY_H_
+#define _PAGEDARRAY_H_
+
+#include <stddef.h>
+#include <vector>
+
+template <typename T>
+class PagedArray
+{
+
+public:
+
+	// Constructor - pass in the number of elements and the value every element starts with
+	PagedArray(int size, const T& defaultValue)
+	{
+
+		this->size = size;
+		this->defaultValue = defaultValue;
+
+		pages.assign((size + PAGE_SIZE - 1) >> PAGE_BITS, (T*)NULL);
+		allocatedPageCount = 0;
+
+	}
+
+	~PagedArray()
+	{
+
+		Release();
+
+	}
+
+	int GetSize() { return size; }
+	// Get the number of bytes currently allocated for elements, not counting the page table
+	size_t GetAllocatedBytes() { return (size_t)allocatedPageCount * PAGE_SIZE * sizeof(T); }
+
+	// Get an element to write to, allocating its page (filled with the default value) if the page hasn't been used yet
+	T& operator[](int index)
+	{
+
+		T*& page = pages[index >> PAGE_BITS];
+
+		if (page == NULL)
+		{
+
+			page = new T[PAGE_SIZE];
+			allocatedPageCount++;
+
+			for (int i = 0; i < PAGE_SIZE; i++)
+			{
+
+				page[i] = defaultValue;
+
+			}
+
+		}
+
+		return page[index & PAGE_MASK];
+
+	}
+
+	// Get an element without allocating; elements on pages that haven't been used read as the default value
+	const T& Get(int index) const
+	{
+
+		const T* page = pages[index >> PAGE_BITS];
+
+		return page != NULL ? page[index & PAGE_MASK] : defaultValue;
+
+	}
+
+	// Free every page, returning every element to the default value
+	void Release()
+	{
+
+		for (size_t i = 0; i < pages.size(); i++)
+		{
+
+			delete[] pages[i];
+			pages[i] = NULL;
+
+		}
+
+		allocatedPageCount = 0;
+
+	}
+
+private:
+
+	// 4096 elements per page: small enough that a local search only touches a few pages, large enough to keep the page table small
+	static const int PAGE_BITS = 12;
+	static const int PAGE_SIZE = 1 << PAGE_BITS;
+	static const int PAGE_MASK = PAGE_SIZE - 1;
+
+	// Copying would share the pages, so it isn't allowed
+	PagedArray(const PagedArray&);
+	PagedArray& operator=(const PagedArray&);
+
+	int size;
+	T defaultValue;
+
+	// One pointer per page, NULL until the page is first written
+	std::vector<T*> pages;
+	int allocatedPageCount;
+
+};
+
+#endif
@@ -0,0 +1,340 @@
+// PathCache.cpp
+
+#include "PathCache.h"
+#include "Heuristic.h"
+#include <algorithm>
+#include <stddef.h>
+
+PathCache::PathCache(Grid* grid, int capacity)
+{
+
+	this->grid = grid;
+	this->capacity = capacity;
+
+	newest = -1;
+	oldest = -1;
+
+	mode = SEARCH_MODE_ASTAR;
+	heuristic = HEURISTIC_OCTILE;
+	heuristicWeight = 1.0;
+
+	version = grid->GetVersion();
+	hitCount = 0;
+	missCount = 0;
+
+}
+
+PathCache::~PathCache()
+{
+
+	grid = NULL;
+
+}
+
+// Look up the result of a query
+bool PathCache::Lookup(int start, int end, std::vector<int>* path, int* cost)
+{
+
+	CheckVersion();
+
+	std::unordered_map<long long, int>::iterator slot = slots.find(GetKey(start, end));
+
+	if (slot == slots.end())
+	{
+
+		missCount++;
+
+		return false;
+
+	}
+
+	Entry& entry = entries[slot->second];
+
+	// Move the entry to the front of the recently used list
+	UnlinkEntry(slot->second);
+	LinkEntry(slot->second);
+
+	*path = entry.path;
+	*cost = entry.cost;
+
+	hitCount++;
+
+	return true;
+
+}
+
+// Store the result of a query, replacing the least recently used entry if the cache is full
+void PathCache::Store(int start, int end, const std::vector<int>& path, int cost)
+{
+
+	CheckVersion();
+
+	if (capacity <= 0)
+	{
+
+		return;
+
+	}
+
+	long long key = GetKey(start, end);
+	std::unordered_map<long long, int>::iterator existing = slots.find(key);
+
+	if (existing != slots.end())
+	{
+
+		RemoveEntry(existing->second);
+
+	}
+	else if ((int)entries.size() >= capacity)
+	{
+
+		RemoveEntry(oldest);
+
+	}
+
+	Entry entry;
+	entry.start = start;
+	entry.end = end;
+	entry.path = path;
+	entry.cost = cost;
+	entry.minX = grid->GetWidth();
+	entry.minY = grid->GetHeight();
+	entry.maxX = -1;
+	entry.maxY = -1;
+
+	for (int index : path)
+	{
+
+		entry.minX = std::min(entry.minX, grid->GetX(index));
+		entry.minY = std::min(entry.minY, grid->GetY(index));
+		entry.maxX = std::max(entry.maxX, grid->GetX(index));
+		entry.maxY = std::max(entry.maxY, grid->GetY(index));
+
+	}
+
+	slots[key] = (int)entries.size();
+	entries.push_back(entry);
+
+	LinkEntry((int)entries.size() - 1);
+
+}
+
+// Set the search settings results are found with, dropping every entry if they've changed
+void PathCache::SetSearchSettings(SearchMode mode, HeuristicType heuristic, double heuristicWeight)
+{
+
+	if (mode != this->mode || heuristic != this->heuristic || heuristicWeight != this->heuristicWeight)
+	{
+
+		Clear();
+
+		this->mode = mode;
+		this->heuristic = heuristic;
+		this->heuristicWeight = heuristicWeight;
+
+	}
+
+}
+
+// Drop the entries a single cell's obstacle edit could have changed
+void PathCache::UpdateCell(int index)
+{
+
+	// Only a single edit since the entries were last checked can be applied selectively
+	if (grid->GetVersion() != version + 1)
+	{
+
+		Clear();
+
+		return;
+
+	}
+
+	version = grid->GetVersion();
+
+	bool isObstacle = grid->IsObstacle(index);
+
+	for (int i = (int)entries.size() - 1; i >= 0; i--)
+	{
+
+		if (IsAffectedBy(entries[i], index, isObstacle))
+		{
+
+			RemoveEntry(i);
+
+		}
+
+	}
+
+}
+
+// Drop every entry
+void PathCache::Clear()
+{
+
+	entries.clear();
+	slots.clear();
+	newest = -1;
+	oldest = -1;
+
+	version = grid->GetVersion();
+
+}
+
+// Get whether an edit to a cell could change an entry's result
+bool PathCache::IsAffectedBy(Entry& entry, int index, bool isObstacle)
+{
+
+	int x = grid->GetX(index);
+	int y = grid->GetY(index);
+
+	if (isObstacle)
+	{
+
+		// A new obstacle can't make any path shorter, so a path that doesn't pass through it is still valid and still the shortest
+		if (entry.cost == -1 || x < entry.minX || x > entry.maxX || y < entry.minY || y > entry.maxY)
+		{
+
+			return false;
+
+		}
+
+		return std::find(entry.path.begin(), entry.path.end(), index) != entry.path.end();
+
+	}
+
+	// A cleared cell might connect a query that had no path
+	if (entry.cost == -1)
+	{
+
+		return true;
+
+	}
+
+	// A cleared cell can only give a shorter path if the shortest possible route through it beats the cached cost
+	// The octile distance is exact on an open grid, so it never overestimates either half of that route
+	int startDistance = EstimateDistance(HEURISTIC_OCTILE, x - grid->GetX(entry.start), y - grid->GetY(entry.start));
+	int endDistance = EstimateDistance(HEURISTIC_OCTILE, grid->GetX(entry.end) - x, grid->GetY(entry.end) - y);
+
+	return startDistance + endDistance < entry.cost;
+
+}
+
+// Remove the entry in a slot, moving the last entry into its place
+void PathCache::RemoveEntry(int slot)
+{
+
+	slots.erase(GetKey(entries[slot].start, entries[slot].end));
+	UnlinkEntry(slot);
+
+	int last = (int)entries.size() - 1;
+
+	if (slot != last)
+	{
+
+		std::swap(entries[slot], entries[last]);
+		slots[GetKey(entries[slot].start, entries[slot].end)] = slot;
+
+		// The moved entry keeps its place in the list, so its neighbours are pointed at its new slot
+		if (entries[slot].previous != -1)
+		{
+
+			entries[entries[slot].previous].next = slot;
+
+		}
+		else
+		{
+
+			newest = slot;
+
+		}
+
+		if (entries[slot].next != -1)
+		{
+
+			entries[entries[slot].next].previous = slot;
+
+		}
+		else
+		{
+
+			oldest = slot;
+
+		}
+
+	}
+
+	entries.pop_back();
+
+}
+
+// Add the entry in a slot to the front of the recently used list
+void PathCache::LinkEntry(int slot)
+{
+
+	entries[slot].previous = -1;
+	entries[slot].next = newest;
+
+	if (newest != -1)
+	{
+
+		entries[newest].previous = slot;
+
+	}
+	else
+	{
+
+		oldest = slot;
+
+	}
+
+	newest = slot;
+
+}
+
+// Take the entry in a slot out of the recently used list
+void PathCache::UnlinkEntry(int slot)
+{
+
+	Entry& entry = entries[slot];
+
+	if (entry.previous != -1)
+	{
+
+		entries[entry.previous].next = entry.next;
+
+	}
+	else
+	{
+
+		newest = entry.next;
+
+	}
+
+	if (entry.next != -1)
+	{
+
+		entries[entry.next].previous = entry.previous;
+
+	}
+	else
+	{
+
+		oldest = entry.previous;
+
+	}
+
+}
+
+// Drop every entry if the grid has been edited without UpdateCell being told
+void PathCache::CheckVersion()
+{
+
+	if (grid->GetVersion() != version)
+	{
+
+		Clear();
+
+	}
+
+}
@@ -0,0 +1,97 @@
+// PathCache class - remembers the results of recent path queries so repeated queries don't have to search again
+// Entries are keyed by start and end cell, and are only dropped when an obstacle edit could actually change them:
+// a new obstacle only affects paths that pass through it, and a cleared obstacle only affects paths it could shorten
+// Entries are also only valid for the search settings they were found with, as weighted searches and inadmissible heuristics
+// give longer paths, so changing the settings drops every entry
+// When the cache is full, the least recently used entry is replaced; entries are kept in a list from most to least recently used,
+// so finding and moving entries in it takes constant time
+
+#ifndef _PATHCACHE_H_
+#define _PATHCACHE_H_
+
+#include <vector>
+#include <unordered_map>
+#include "Grid.h"
+#include "Pathfinder.h"
+
+class PathCache
+{
+
+public:
+
+	// Constructor - pass in the grid the cached paths were found on and the most entries to keep
+	PathCache(Grid* grid, int capacity);
+	~PathCache();
+
+	// Look up the result of a query, returning true if it's cached
+	// Fills in the path (start to end) and its cost, or an empty path and a cost of -1 if the query was found to have no path
+	bool Lookup(int start, int end, std::vector<int>* path, int* cost);
+	// Store the result of a query, with a cost of -1 if it has no path
+	void Store(int start, int end, const std::vector<int>& path, int cost);
+	// Set the search settings the results being looked up and stored are found with, dropping every entry if they've changed
+	void SetSearchSettings(SearchMode mode, HeuristicType heuristic, double heuristicWeight);
+
+	// Drop the entries a single cell's obstacle edit could have changed
+	// Must be called after every edit; if an edit is missed, every entry is dropped the next time the cache is used
+	void UpdateCell(int index);
+	// Drop every entry
+	void Clear();
+
+	int GetEntryCount() { return (int)slots.size(); }
+	// Get the number of lookups that found or didn't find an entry, for measuring how well the cache is working
+	int GetHitCount() { return hitCount; }
+	int GetMissCount() { return missCount; }
+
+private:
+
+	// A cached query result, with the bounds of its path so most edits can rule it out without checking every cell
+	struct Entry
+	{
+		int start;
+		int end;
+		std::vector<int> path;
+		int cost;
+		int minX;
+		int minY;
+		int maxX;
+		int maxY;
+		// Slots of the next more and less recently used entries, -1 at either end of the list
+		int previous;
+		int next;
+	};
+
+	// Get the key an entry is stored under
+	long long GetKey(int start, int end) { return ((long long)start * grid->GetCellCount()) + end; }
+	// Get whether an edit to a cell could change an entry's result
+	bool IsAffectedBy(Entry& entry, int index, bool isObstacle);
+	// Remove the entry in a slot, moving the last entry into its place
+	void RemoveEntry(int slot);
+	// Add the entry in a slot to the front of the recently used list, or take it out of the list
+	void LinkEntry(int slot);
+	void UnlinkEntry(int slot);
+	// Drop every entry if the grid has been edited without UpdateCell being told
+	void CheckVersion();
+
+	Grid* grid;
+	int capacity;
+
+	std::vector<Entry> entries;
+	// Slot in entries for each key
+	std::unordered_map<long long, int> slots;
+	// Slots of the most and least recently used entries, -1 if there are no entries
+	int newest;
+	int oldest;
+
+	// The search settings the entries were found with
+	SearchMode mode;
+	HeuristicType heuristic;
+	double heuristicWeight;
+
+	// The grid version the entries are known to be current with
+	int version;
+	int hitCount;
+	int missCount;
+
+};
+
+#endif
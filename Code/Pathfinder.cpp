@@ -0,0 +1,1168 @@
+// Pathfinder.cpp
+
+#include "Pathfinder.h"
+#include <algorithm>
+#include <chrono>
+#include <stdlib.h>
+#include <limits.h>
+
+// Get a readable name for a search mode
+const char* GetSearchModeName(SearchMode mode)
+{
+
+	switch (mode)
+	{
+
+	case SEARCH_MODE_ASTAR:
+		return "A*";
+
+	case SEARCH_MODE_JPS:
+		return "JPS";
+
+	case SEARCH_MODE_JPS_PLUS:
+		return "JPS+";
+
+	case SEARCH_MODE_BIDIRECTIONAL:
+		return "Bidirectional A*";
+
+	case SEARCH_MODE_WEIGHTED_ASTAR:
+		return "Weighted A*";
+
+	case SEARCH_MODE_ANYTIME:
+		return "ARA*";
+
+	default:
+		return "Unknown";
+
+	}
+
+}
+
+// Get the sign of a value (-1, 0 or 1)
+static int Sign(int value)
+{
+
+	return (value > 0) - (value < 0);
+
+}
+
+// Straight jumps are scanned 63 cells at a time, so the bit after each scanned cell is in the same 64-bit read
+static const int SCAN_LENGTH = 63;
+static const uint64_t SCAN_MASK = ~(uint64_t)0 >> 1;
+
+// Reverse the order of the bits in a word
+static uint64_t ReverseBits(uint64_t bits)
+{
+
+	bits = ((bits >> 1) & 0x5555555555555555ull) | ((bits & 0x5555555555555555ull) << 1);
+	bits = ((bits >> 2) & 0x3333333333333333ull) | ((bits & 0x3333333333333333ull) << 2);
+	bits = ((bits >> 4) & 0x0F0F0F0F0F0F0F0Full) | ((bits & 0x0F0F0F0F0F0F0F0Full) << 4);
+	bits = ((bits >> 8) & 0x00FF00FF00FF00FFull) | ((bits & 0x00FF00FF00FF00FFull) << 8);
+	bits = ((bits >> 16) & 0x0000FFFF0000FFFFull) | ((bits & 0x0000FFFF0000FFFFull) << 16);
+
+	return (bits >> 32) | (bits << 32);
+
+}
+
+Pathfinder::Pathfinder(Grid* grid) : forward(grid->GetCellCount()), backward(grid->GetCellCount())
+{
+
+	this->grid = grid;
+
+	startIndex = -1;
+	endIndex = -1;
+	meetingIndex = -1;
+	pathCost = INT_MAX;
+	expansionCount = 0;
+	weight = 1.0;
+	suboptimalityBound = 1.0;
+	solutionCount = 0;
+
+	jumpPoints = &ownJumpPoints;
+	isJumpTableUsed = false;
+	components = NULL;
+
+	forward.targetX = 0;
+	forward.targetY = 0;
+	backward.targetX = 0;
+	backward.targetY = 0;
+
+	// Node pages start out stamped with generation 0, so they're stale as soon as the first search begins
+	generation = 0;
+
+	mode = SEARCH_MODE_ASTAR;
+	heuristic = HEURISTIC_OCTILE;
+	heuristicWeight = 2.0;
+	allowReopening = true;
+
+	Reset();
+
+}
+
+Pathfinder::~Pathfinder()
+{
+
+	grid = NULL;
+
+}
+
+// Run a full search from the start cell to the end cell
+bool Pathfinder::FindPath(int start, int end, std::vector<int>* path)
+{
+
+	Begin(start, end);
+	Advance(0, 0);
+
+	return GetPath(path);
+
+}
+
+// Start a new search, seeding the open set with the start cell
+void Pathfinder::Begin(int start, int end)
+{
+
+	Reset();
+
+	STATS_TIME_SCOPE(stats.setupNanoseconds);
+
+	startIndex = start;
+	endIndex = end;
+	forward.targetX = grid->GetX(end);
+	forward.targetY = grid->GetY(end);
+	backward.targetX = grid->GetX(start);
+	backward.targetY = grid->GetY(start);
+
+	// Only the weighted searches inflate the heuristic; every other search finds the shortest path
+	weight = mode == SEARCH_MODE_WEIGHTED_ASTAR || mode == SEARCH_MODE_ANYTIME ? std::max(heuristicWeight, 1.0) : 1.0;
+	suboptimalityBound = weight;
+
+	// Bring the JPS+ jump distances up to date with any obstacle edits
+	if (mode == SEARCH_MODE_JPS_PLUS && jumpPoints == &ownJumpPoints && !ownJumpPoints.IsBuiltFor(grid))
+	{
+
+		ownJumpPoints.Build(grid);
+
+	}
+
+	// Without an up to date table, e.g. on a grid too large to build one for, JPS+ falls back to scanning for jump points as JPS does
+	isJumpTableUsed = mode == SEARCH_MODE_JPS_PLUS && jumpPoints->IsBuiltFor(grid);
+
+	// Fail straight away if either cell is an obstacle, or the end cell is in a different region to the start cell,
+	// rather than exhausting the start cell's region
+	if (grid->IsObstacle(startIndex) || grid->IsObstacle(endIndex) ||
+		(components != NULL && components->IsBuiltFor(grid) && !components->AreConnected(startIndex, endIndex)))
+	{
+
+		status = SEARCH_FAILED;
+
+		return;
+
+	}
+
+	OpenNode(forward, startIndex, 0, -1);
+
+	// Bidirectional searches also search back from the end cell; the two sides meet straight away if start and end match
+	if (mode == SEARCH_MODE_BIDIRECTIONAL)
+	{
+
+		OpenNode(backward, endIndex, 0, -1);
+		CheckMeeting(endIndex);
+
+	}
+
+	status = SEARCH_RUNNING;
+
+}
+
+// Expand the cheapest cell in the open set
+SearchStatus Pathfinder::Step()
+{
+
+	if (status != SEARCH_RUNNING)
+	{
+
+		return status;
+
+	}
+
+	if (mode == SEARCH_MODE_BIDIRECTIONAL)
+	{
+
+		return StepBidirectional();
+
+	}
+
+	if (mode == SEARCH_MODE_ANYTIME)
+	{
+
+		return StepAnytime();
+
+	}
+
+	// Nothing left to expand, so the end cell can't be reached
+	if (forward.openSet.IsEmpty())
+	{
+
+		status = SEARCH_FAILED;
+		return status;
+
+	}
+
+	// Take the cell in the open set with the lowest cost and add it to the closed set
+	int current = -1;
+
+	{
+
+		STATS_TIME_SCOPE(stats.selectNanoseconds);
+		current = forward.openSet.Pop();
+
+	}
+
+	Node& currentNode = GetNode(forward, current);
+	currentNode.isOpen = false;
+	currentNode.isClosed = true;
+
+	// Check if the current cell is the end cell
+	if (current == endIndex)
+	{
+
+		pathCost = currentNode.gCost;
+		status = SEARCH_FOUND;
+		return status;
+
+	}
+
+	expansionCount++;
+
+	STATS_TIME_SCOPE(stats.expandNanoseconds);
+
+	if (mode == SEARCH_MODE_JPS || mode == SEARCH_MODE_JPS_PLUS)
+	{
+
+		SearchJumpPoints(current);
+
+	}
+	else
+	{
+
+		SearchNeighbourhood(forward, current);
+
+	}
+
+	return status;
+
+}
+
+// Expand cells until the search finishes or a budget runs out
+SearchStatus Pathfinder::Advance(int maxExpansions, int maxMicroseconds)
+{
+
+	// Reading the clock costs about as much as expanding a cell, so it's only checked this often
+	const int TIME_CHECK_INTERVAL = 16;
+
+	std::chrono::steady_clock::time_point deadline = std::chrono::steady_clock::now() + std::chrono::microseconds(maxMicroseconds);
+
+	for (int expansions = 1; Step() == SEARCH_RUNNING; expansions++)
+	{
+
+		if (maxExpansions > 0 && expansions >= maxExpansions)
+		{
+
+			break;
+
+		}
+
+		if (maxMicroseconds > 0 && expansions % TIME_CHECK_INTERVAL == 0 && std::chrono::steady_clock::now() >= deadline)
+		{
+
+			break;
+
+		}
+
+	}
+
+	return status;
+
+}
+
+// Expand one cell from whichever direction has the higher lowest f-cost
+SearchStatus Pathfinder::StepBidirectional()
+{
+
+	// Once either side runs out of cells, the best meeting point found so far (if any) gives the shortest path
+	if (forward.openSet.IsEmpty() || backward.openSet.IsEmpty())
+	{
+
+		status = meetingIndex != -1 ? SEARCH_FOUND : SEARCH_FAILED;
+		return status;
+
+	}
+
+	// Every path through a cell still to be expanded costs at least the lowest f-cost on either side,
+	// so nothing cheaper can turn up once either side's cheapest f-cost reaches the best path found
+	if (meetingIndex != -1 && std::max(forward.openSet.TopFCost(), backward.openSet.TopFCost()) >= pathCost)
+	{
+
+		status = SEARCH_FOUND;
+		return status;
+
+	}
+
+	// Expanding the side with the higher lowest f-cost raises the bound above fastest, so the search can stop sooner;
+	// expanding the lower side instead keeps both sides' f-costs level and costs more expansions before either reaches the path cost
+	int forwardFCost = forward.openSet.TopFCost();
+	int backwardFCost = backward.openSet.TopFCost();
+	bool isForward = forwardFCost != backwardFCost ? forwardFCost > backwardFCost : forward.openSet.GetSize() <= backward.openSet.GetSize();
+	Frontier& frontier = isForward ? forward : backward;
+
+	int current = -1;
+
+	{
+
+		STATS_TIME_SCOPE(stats.selectNanoseconds);
+		current = frontier.openSet.Pop();
+
+	}
+
+	Node& currentNode = GetNode(frontier, current);
+	currentNode.isOpen = false;
+	currentNode.isClosed = true;
+
+	expansionCount++;
+
+	STATS_TIME_SCOPE(stats.expandNanoseconds);
+
+	SearchNeighbourhood(frontier, current);
+
+	return status;
+
+}
+
+// Expand one cell of the current ARA* pass
+// Closed cells aren't reopened within a pass; cells whose costs drop after they're closed wait for the next pass instead
+SearchStatus Pathfinder::StepAnytime()
+{
+
+	// The pass is over once nothing left in the open set could lead to the end cell more cheaply than the route already found to it,
+	// which gives a path at most the current weight times longer than the shortest
+	bool isEndReached = IsCurrent(forward, endIndex) && (forward.nodes.Get(endIndex).isOpen || forward.nodes.Get(endIndex).isClosed);
+
+	if (forward.openSet.IsEmpty() || (isEndReached && forward.openSet.TopFCost() >= forward.nodes.Get(endIndex).gCost))
+	{
+
+		// Each pass can only lower costs, so only the first pass can run out of cells without reaching the end cell
+		if (!isEndReached)
+		{
+
+			status = SEARCH_FAILED;
+			return status;
+
+		}
+
+		FinishPass();
+
+		return status;
+
+	}
+
+	int current = -1;
+
+	{
+
+		STATS_TIME_SCOPE(stats.selectNanoseconds);
+		current = forward.openSet.Pop();
+
+	}
+
+	Node& currentNode = GetNode(forward, current);
+	currentNode.isOpen = false;
+	currentNode.isClosed = true;
+
+	expansionCount++;
+
+	STATS_TIME_SCOPE(stats.expandNanoseconds);
+
+	SearchNeighbourhood(forward, current);
+
+	return status;
+
+}
+
+// Keep the path from a finished ARA* pass, then lower the weight and set the open set up for the next pass
+void Pathfinder::FinishPass()
+{
+
+	// How much the weight is lowered by after each pass
+	const double WEIGHT_STEP = 0.5;
+
+	// Cells closed this pass keep the parent links they had when their costs were last lowered, so the path traced can cost less than
+	// the end cell's g-cost, and can even cost more than the last pass's path; it's only kept if it's an improvement
+	{
+
+		STATS_TIME_SCOPE(stats.traceNanoseconds);
+
+		std::vector<int> passPath;
+		TracePath(forward, endIndex, &passPath);
+		std::reverse(passPath.begin(), passPath.end());
+
+		int passCost = 0;
+
+		for (size_t i = 1; i < passPath.size(); i++)
+		{
+
+			int direction = GetDirectionIndex(grid->GetX(passPath[i]) - grid->GetX(passPath[i - 1]), grid->GetY(passPath[i]) - grid->GetY(passPath[i - 1]));
+
+			passCost += DIRECTIONS[direction].cost;
+
+		}
+
+		if (passCost < pathCost)
+		{
+
+			anytimePath.swap(passPath);
+			pathCost = passCost;
+			solutionCount++;
+
+		}
+
+	}
+
+	// No path can cost less than the lowest unweighted cost of the open and inconsistent cells, which often gives a tighter bound than the weight
+	// Closed cells are opened up again for the next pass, keeping their costs
+	std::vector<int> waitingCells;
+	int lowestCost = INT_MAX;
+
+	for (int index : touchedCells)
+	{
+
+		Node& node = forward.nodes[index];
+
+		if (node.generation != generation)
+		{
+
+			continue;
+
+		}
+
+		if (node.isOpen || node.isInconsistent)
+		{
+
+			waitingCells.push_back(index);
+			lowestCost = std::min(lowestCost, node.gCost + node.hCost);
+
+		}
+
+		if (node.isClosed)
+		{
+
+			node.isClosed = false;
+			node.isSettled = true;
+
+		}
+
+	}
+
+	suboptimalityBound = lowestCost >= pathCost ? 1.0 : std::min(weight, (double)pathCost / lowestCost);
+
+	if (weight <= 1.0 || suboptimalityBound <= 1.0)
+	{
+
+		suboptimalityBound = 1.0;
+		status = SEARCH_FOUND;
+
+		return;
+
+	}
+
+	weight = std::max(weight - WEIGHT_STEP, 1.0);
+
+	// Put every waiting cell back in the open set with its costs weighted for the next pass
+	forward.openSet.Clear();
+
+	for (int index : waitingCells)
+	{
+
+		Node& node = forward.nodes[index];
+
+		if (node.isInconsistent)
+		{
+
+			STATS_COUNT(stats.insertions);
+			STATS_COUNT(stats.reopens);
+
+		}
+
+		node.fCost = node.gCost + (int)(node.hCost * weight);
+		node.isOpen = true;
+		node.isInconsistent = false;
+
+		forward.openSet.Push(index, node.fCost, node.gCost);
+
+	}
+
+	STATS_PEAK(stats.peakOpenSetSize, forward.openSet.GetSize());
+
+}
+
+// Record a cell as the meeting point if both directions have reached it and it gives a cheaper path
+void Pathfinder::CheckMeeting(int index)
+{
+
+	if (!IsCurrent(forward, index) || !IsCurrent(backward, index))
+	{
+
+		return;
+
+	}
+
+	const Node& forwardNode = forward.nodes.Get(index);
+	const Node& backwardNode = backward.nodes.Get(index);
+
+	// Both sides must have actually reached the cell, not just stamped it while looking at it
+	if (!(forwardNode.isOpen || forwardNode.isClosed) || !(backwardNode.isOpen || backwardNode.isClosed))
+	{
+
+		return;
+
+	}
+
+	int cost = forwardNode.gCost + backwardNode.gCost;
+
+	if (cost < pathCost)
+	{
+
+		pathCost = cost;
+		meetingIndex = index;
+
+	}
+
+}
+
+// Use a jump point table shared with other pathfinders for JPS+
+void Pathfinder::SetJumpPointTable(JumpPointTable* table)
+{
+
+	jumpPoints = table != NULL ? table : &ownJumpPoints;
+
+}
+
+// Use region labels to reject unreachable queries
+void Pathfinder::SetComponents(ConnectedComponents* components)
+{
+
+	this->components = components;
+
+}
+
+// Clear all search state
+void Pathfinder::Reset()
+{
+
+	generation++;
+
+	// Once the counter wraps around, old stamps could match again, so free every page to bring all cells back to blank
+	if (generation == 0)
+	{
+
+		forward.nodes.Release();
+		backward.nodes.Release();
+
+		generation = 1;
+
+	}
+
+	touchedCells.clear();
+	forward.openSet.Clear();
+	backward.openSet.Clear();
+
+	meetingIndex = -1;
+	pathCost = INT_MAX;
+	expansionCount = 0;
+	solutionCount = 0;
+	anytimePath.clear();
+	ResetSearchStats(&stats);
+
+	status = SEARCH_IDLE;
+
+}
+
+// Trace back from the end cell to get the path
+bool Pathfinder::GetPath(std::vector<int>* path)
+{
+
+	STATS_TIME_SCOPE(stats.traceNanoseconds);
+
+	path->clear();
+
+	if (GetSolutionCount() == 0)
+	{
+
+		return false;
+
+	}
+
+	if (mode == SEARCH_MODE_ANYTIME)
+	{
+
+		*path = anytimePath;
+
+		return true;
+
+	}
+
+	if (mode != SEARCH_MODE_BIDIRECTIONAL)
+	{
+
+		TracePath(forward, endIndex, path);
+		std::reverse(path->begin(), path->end());
+
+		return true;
+
+	}
+
+	// Join the forward half (start to meeting cell) to the backward half (meeting cell to end), which shares the meeting cell
+	TracePath(forward, meetingIndex, path);
+	std::reverse(path->begin(), path->end());
+
+	std::vector<int> backwardPath;
+	TracePath(backward, meetingIndex, &backwardPath);
+	path->insert(path->end(), backwardPath.begin() + 1, backwardPath.end());
+
+	return true;
+
+}
+
+// Follow parent links from a cell back to the cell a frontier started at, appending each cell to the path
+void Pathfinder::TracePath(Frontier& frontier, int index, std::vector<int>* path)
+{
+
+	for (; index != -1; index = frontier.nodes.Get(index).parent)
+	{
+
+		path->push_back(index);
+
+		int parent = frontier.nodes.Get(index).parent;
+
+		if (parent == -1)
+		{
+
+			break;
+
+		}
+
+		// Fill in the cells skipped over by a jump; jumps are always straight or exactly diagonal
+		int x = grid->GetX(index);
+		int y = grid->GetY(index);
+		int stepX = Sign(grid->GetX(parent) - x);
+		int stepY = Sign(grid->GetY(parent) - y);
+
+		for (x += stepX, y += stepY; grid->GetIndex(x, y) != parent; x += stepX, y += stepY)
+		{
+
+			path->push_back(grid->GetIndex(x, y));
+
+		}
+
+	}
+
+}
+
+// Get a cell's search state, clearing it first if it was last written by an earlier search
+Pathfinder::Node& Pathfinder::GetNode(Frontier& frontier, int index)
+{
+
+	Node& node = frontier.nodes[index];
+
+	if (node.generation != generation)
+	{
+
+		node.gCost = 0;
+		node.hCost = 0;
+		node.fCost = 0;
+		node.parent = -1;
+		node.generation = generation;
+		node.isOpen = false;
+		node.isClosed = false;
+		node.isInconsistent = false;
+		node.isSettled = false;
+
+		// Cells reached by both sides of a bidirectional search are only listed once
+		if (&frontier == &forward || !IsCurrent(forward, index))
+		{
+
+			touchedCells.push_back(index);
+
+		}
+
+	}
+
+	return node;
+
+}
+
+// Find the costs for a cell and add or move it into the open set
+void Pathfinder::OpenNode(Frontier& frontier, int index, int gCost, int parent)
+{
+
+	Node& node = GetNode(frontier, index);
+
+	node.gCost = gCost;
+	node.hCost = Heuristic(frontier, index);
+	node.fCost = node.gCost + (weight == 1.0 ? node.hCost : (int)(node.hCost * weight));
+	node.parent = parent;
+
+	// Cells already in the open set can only have their costs lowered
+	if (node.isOpen)
+	{
+
+		frontier.openSet.DecreaseKey(index, node.fCost, node.gCost);
+		STATS_COUNT(stats.decreaseKeys);
+
+	}
+	else
+	{
+
+		frontier.openSet.Push(index, node.fCost, node.gCost);
+		STATS_COUNT(stats.insertions);
+		STATS_PEAK(stats.peakOpenSetSize, forward.openSet.GetSize() + backward.openSet.GetSize());
+
+	}
+
+	node.isOpen = true;
+	node.isClosed = false;
+
+}
+
+// Search a cell's neighbourhood (Moore neighbourhood) for cells that need to be updated
+// Both directions of a bidirectional search use this, checking each improved neighbour against the other side
+void Pathfinder::SearchNeighbourhood(Frontier& frontier, int index)
+{
+
+	int x = grid->GetX(index);
+	int y = grid->GetY(index);
+	int currentGCost = frontier.nodes.Get(index).gCost;
+	unsigned int passable = grid->GetNeighbourMask(x, y);
+
+	for (int i = 0; i < DIRECTION_COUNT; i++)
+	{
+
+		// Skip any neighbours that are obstacles or fall outside the grid
+		if ((passable & (1u << i)) == 0)
+		{
+
+			continue;
+
+		}
+
+		int neighbour = index + grid->GetNeighbourOffset(i);
+
+		// The new g-cost is the cost of getting from the cell this direction started at to here
+		UpdateNeighbour(frontier, index, neighbour, currentGCost + DIRECTIONS[i].cost);
+
+		if (mode == SEARCH_MODE_BIDIRECTIONAL)
+		{
+
+			CheckMeeting(neighbour);
+
+		}
+
+	}
+
+}
+
+// Update a neighbour reached from a cell if the new g-cost is an improvement
+void Pathfinder::UpdateNeighbour(Frontier& frontier, int index, int neighbour, int newGCost)
+{
+
+	Node& node = GetNode(frontier, neighbour);
+
+	// If it's already in the open set, only update it if the new g-cost is an improvement
+	if (node.isOpen)
+	{
+
+		if (newGCost < node.gCost)
+		{
+
+			OpenNode(frontier, neighbour, newGCost, index);
+
+		}
+
+	}
+	// Else if it's in the closed set and the new g-cost is an improvement, move it back to the open set
+	else if (node.isClosed)
+	{
+
+		// ARA* leaves it closed for the rest of the pass, keeping the lower cost and reopening it when the next pass starts
+		if (mode == SEARCH_MODE_ANYTIME && newGCost < node.gCost)
+		{
+
+			node.gCost = newGCost;
+			node.parent = index;
+
+			node.isInconsistent = true;
+
+		}
+		else if (allowReopening && newGCost < node.gCost)
+		{
+
+			OpenNode(frontier, neighbour, newGCost, index);
+			STATS_COUNT(stats.reopens);
+
+		}
+
+	}
+	// Else add to open set, unless it was settled by an earlier ARA* pass and the new g-cost is no improvement
+	else if (!node.isSettled || newGCost < node.gCost)
+	{
+
+		OpenNode(frontier, neighbour, newGCost, index);
+
+	}
+
+}
+
+// Search from a cell along each direction that JPS doesn't prune, adding the jump points found
+void Pathfinder::SearchJumpPoints(int index)
+{
+
+	int directions[DIRECTION_COUNT];
+	int directionCount = FindJumpDirections(index, directions);
+
+	int x = grid->GetX(index);
+	int y = grid->GetY(index);
+	int currentGCost = forward.nodes.Get(index).gCost;
+
+	for (int i = 0; i < directionCount; i++)
+	{
+
+		const Direction& direction = DIRECTIONS[directions[i]];
+
+		int jumpPoint = -1;
+
+		if (isJumpTableUsed)
+		{
+
+			jumpPoint = JumpFromTable(index, directions[i]);
+
+		}
+		else
+		{
+
+			jumpPoint = Jump(x, y, direction.x, direction.y);
+
+		}
+
+		if (jumpPoint == -1)
+		{
+
+			continue;
+
+		}
+
+		// Jumps are straight or exactly diagonal, so the cost is the number of steps times the step cost
+		int steps = std::max(abs(grid->GetX(jumpPoint) - x), abs(grid->GetY(jumpPoint) - y));
+
+		UpdateNeighbour(forward, index, jumpPoint, currentGCost + (steps * direction.cost));
+
+	}
+
+}
+
+// Find the directions JPS needs to search from a cell
+// Diagonal moves are allowed whenever the destination cell is free, matching the A* neighbourhood
+int Pathfinder::FindJumpDirections(int index, int* directions)
+{
+
+	int count = 0;
+	int parent = forward.nodes.Get(index).parent;
+
+	// The start cell has no direction of travel, so every direction is searched
+	if (parent == -1)
+	{
+
+		for (int i = 0; i < DIRECTION_COUNT; i++)
+		{
+
+			directions[count++] = i;
+
+		}
+
+		return count;
+
+	}
+
+	int x = grid->GetX(index);
+	int y = grid->GetY(index);
+	int directionX = Sign(x - grid->GetX(parent));
+	int directionY = Sign(y - grid->GetY(parent));
+
+	if (directionX != 0 && directionY != 0)
+	{
+
+		// Natural neighbours: carry on diagonally, or along either of its straight components
+		directions[count++] = GetDirectionIndex(directionX, directionY);
+		directions[count++] = GetDirectionIndex(directionX, 0);
+		directions[count++] = GetDirectionIndex(0, directionY);
+
+		// Forced neighbours: turn around a blocked cell behind the direction of travel
+		if (!grid->IsPassable(x - directionX, y))
+		{
+
+			directions[count++] = GetDirectionIndex(-directionX, directionY);
+
+		}
+
+		if (!grid->IsPassable(x, y - directionY))
+		{
+
+			directions[count++] = GetDirectionIndex(directionX, -directionY);
+
+		}
+
+	}
+	else if (directionX != 0)
+	{
+
+		directions[count++] = GetDirectionIndex(directionX, 0);
+
+		if (!grid->IsPassable(x, y + 1))
+		{
+
+			directions[count++] = GetDirectionIndex(directionX, 1);
+
+		}
+
+		if (!grid->IsPassable(x, y - 1))
+		{
+
+			directions[count++] = GetDirectionIndex(directionX, -1);
+
+		}
+
+	}
+	else
+	{
+
+		directions[count++] = GetDirectionIndex(0, directionY);
+
+		if (!grid->IsPassable(x + 1, y))
+		{
+
+			directions[count++] = GetDirectionIndex(1, directionY);
+
+		}
+
+		if (!grid->IsPassable(x - 1, y))
+		{
+
+			directions[count++] = GetDirectionIndex(-1, directionY);
+
+		}
+
+	}
+
+	return count;
+
+}
+
+// Move from a cell in a direction until a jump point is found, returning it or -1 if a wall is hit first
+int Pathfinder::Jump(int x, int y, int directionX, int directionY)
+{
+
+	if (directionX == 0 || directionY == 0)
+	{
+
+		return JumpStraight(x, y, directionX, directionY);
+
+	}
+
+	// Neighbours that decide whether a diagonal step has forced neighbours, as bits of the neighbour mask
+	unsigned int behindX = 1u << GetDirectionIndex(-directionX, 0);
+	unsigned int behindXOpen = 1u << GetDirectionIndex(-directionX, directionY);
+	unsigned int behindY = 1u << GetDirectionIndex(0, -directionY);
+	unsigned int behindYOpen = 1u << GetDirectionIndex(directionX, -directionY);
+
+	while (true)
+	{
+
+		x += directionX;
+		y += directionY;
+
+		if (!grid->IsPassable(x, y))
+		{
+
+			return -1;
+
+		}
+
+		int index = grid->GetIndex(x, y);
+
+		if (index == endIndex)
+		{
+
+			return index;
+
+		}
+
+		// Stop where a blocked cell behind the direction of travel opens up
+		unsigned int passable = grid->GetNeighbourMask(x, y);
+
+		if (((passable & behindXOpen) != 0 && (passable & behindX) == 0) ||
+			((passable & behindYOpen) != 0 && (passable & behindY) == 0))
+		{
+
+			return index;
+
+		}
+
+		// Stop where either straight component leads to a jump point
+		if (JumpStraight(x, y, directionX, 0) != -1 || JumpStraight(x, y, 0, directionY) != -1)
+		{
+
+			return index;
+
+		}
+
+	}
+
+}
+
+// Move from a cell along a row or column until a jump point is found, checking a word of cells at a time
+// Horizontal jumps read the row layer of the grid and vertical jumps read the column layer, so both are scanned the same way
+int Pathfinder::JumpStraight(int x, int y, int directionX, int directionY)
+{
+
+	bool isRow = directionY == 0;
+	int line = isRow ? y : x;
+	int step = isRow ? directionX : directionY;
+	int first = (isRow ? x : y) + step;
+
+	// Offset from the first scanned cell to the end cell, if the end cell lies ahead on this line
+	int endOffset = -1;
+	int endLine = isRow ? forward.targetY : forward.targetX;
+	int endPosition = isRow ? forward.targetX : forward.targetY;
+
+	if (endLine == line && (endPosition - first) * step >= 0)
+	{
+
+		endOffset = (endPosition - first) * step;
+
+	}
+
+	while (true)
+	{
+
+		// Bit i of each word is the cell i steps along from the first scanned cell, on this line and the lines either side of it
+		uint64_t through = ReadLine(isRow, line, first, step);
+		uint64_t before = ReadLine(isRow, line - 1, first, step);
+		uint64_t after = ReadLine(isRow, line + 1, first, step);
+
+		// A cell is a jump point where the cell beside it is blocked but the next cell along from that one isn't
+		uint64_t blocked = ~through;
+		uint64_t forced = ((before >> 1) & ~before) | ((after >> 1) & ~after);
+		uint64_t end = endOffset >= 0 && endOffset < SCAN_LENGTH ? (uint64_t)1 << endOffset : 0;
+		uint64_t stops = (blocked | forced | end) & SCAN_MASK;
+
+		if (stops != 0)
+		{
+
+			int offset = FindLowestBit(stops);
+
+			if ((blocked >> offset) & 1)
+			{
+
+				return -1;
+
+			}
+
+			int position = first + (offset * step);
+
+			return isRow ? grid->GetIndex(position, line) : grid->GetIndex(line, position);
+
+		}
+
+		first += SCAN_LENGTH * step;
+		endOffset -= SCAN_LENGTH;
+
+	}
+
+}
+
+// Read 64 cells of a row or column, starting at a cell and moving in either direction along the line
+uint64_t Pathfinder::ReadLine(bool isRow, int line, int first, int step)
+{
+
+	if (step > 0)
+	{
+
+		return isRow ? grid->GetRowBits(first, line) : grid->GetColumnBits(line, first);
+
+	}
+
+	// Read the 64 cells ending at the first cell, then flip them so the first cell is in the lowest bit
+	uint64_t bits = isRow ? grid->GetRowBits(first - 63, line) : grid->GetColumnBits(line, first - 63);
+
+	return ReverseBits(bits);
+
+}
+
+// Find the jump point in a direction from a cell using the precomputed table
+// The table doesn't know about the end cell, so jumps that pass it (or line up with it diagonally) are cut short here
+int Pathfinder::JumpFromTable(int index, int direction)
+{
+
+	const Direction& step = DIRECTIONS[direction];
+	int distance = jumpPoints->GetDistance(index, direction);
+	int x = grid->GetX(index);
+	int y = grid->GetY(index);
+	int differenceX = forward.targetX - x;
+	int differenceY = forward.targetY - y;
+
+	if (step.x == 0 || step.y == 0)
+	{
+
+		// Stop at the end cell if it lies on this line before any wall or jump point
+		bool isOnLine = step.x != 0 ? (differenceY == 0 && Sign(differenceX) == step.x) : (differenceX == 0 && Sign(differenceY) == step.y);
+		int steps = abs(differenceX) + abs(differenceY);
+
+		if (isOnLine && steps <= abs(distance))
+		{
+
+			return endIndex;
+
+		}
+
+	}
+	else if (Sign(differenceX) == step.x && Sign(differenceY) == step.y)
+	{
+
+		// Stop where the end cell lines up straight ahead, since a straight jump from there can reach it
+		int steps = std::min(abs(differenceX), abs(differenceY));
+
+		if (steps <= abs(distance))
+		{
+
+			return grid->GetIndex(x + (step.x * steps), y + (step.y * steps));
+
+		}
+
+	}
+
+	if (distance > 0)
+	{
+
+		return grid->GetIndex(x + (step.x * distance), y + (step.y * distance));
+
+	}
+
+	return -1;
+
+}
+
+// Estimate the distance from a cell to the cell a frontier is searching towards using the selected heuristic
+int Pathfinder::Heuristic(Frontier& frontier, int index)
+{
+
+	return EstimateDistance(heuristic, frontier.targetX - grid->GetX(index), frontier.targetY - grid->GetY(index));
+
+}
@@ -0,0 +1,247 @@
+// Pathfinder class - headless A* search over a Grid
+// Owns all search state (costs, parent links, open & closed sets) so it can be used without SFML or a window
+// Search state is stamped with a generation counter, so starting a new search never has to clear the whole grid
+// Supports both running a query to completion and stepping through it one expansion at a time
+// Can also run Jump Point Search (JPS) and JPS+, which find paths of the same length as A* while expanding far fewer cells,
+// and bidirectional A*, which searches from both ends at once and stops once the two searches can't find a cheaper meeting point;
+// it doesn't expand fewer cells than A* in general, as both searches run on until one can rule out a cheaper meeting point
+// Weighted A* and ARA* trade path length for speed: weighted A* inflates the heuristic to reach the end cell sooner with a path at most
+// a given factor longer than the shortest, and ARA* (anytime repairing A*) finds such a path first, then keeps lowering the weight and
+// repairing its search to find shorter ones, reusing the work of each pass in the next, until the path is the shortest or time runs out
+
+#ifndef _PATHFINDER_H_
+#define _PATHFINDER_H_
+
+#include <vector>
+#include "Grid.h"
+#include "OpenSet.h"
+#include "PagedArray.h"
+#include "Heuristic.h"
+#include "JumpPointTable.h"
+#include "ConnectedComponents.h"
+#include "SearchStats.h"
+
+// Result of advancing a search
+enum SearchStatus
+{
+	SEARCH_IDLE,
+	SEARCH_RUNNING,
+	SEARCH_FOUND,
+	SEARCH_FAILED
+};
+
+// The ways the pathfinder can search the grid
+enum SearchMode
+{
+	// Plain A*, expanding the whole Moore neighbourhood of each cell
+	SEARCH_MODE_ASTAR,
+	// Jump Point Search, scanning along straight and diagonal lines to skip symmetric paths
+	SEARCH_MODE_JPS,
+	// JPS+, reading jump distances from a table precomputed whenever the obstacles change
+	SEARCH_MODE_JPS_PLUS,
+	// A* from both the start and end cells, expanding whichever side has the higher lowest f-cost
+	SEARCH_MODE_BIDIRECTIONAL,
+	// A* with the heuristic multiplied by the heuristic weight, giving paths at most that many times longer than the shortest
+	SEARCH_MODE_WEIGHTED_ASTAR,
+	// ARA*, starting at the heuristic weight and lowering it after each path is found until it reaches 1
+	SEARCH_MODE_ANYTIME,
+	SEARCH_MODE_COUNT
+};
+
+// Get a readable name for a search mode
+const char* GetSearchModeName(SearchMode mode);
+
+class Pathfinder
+{
+
+public:
+
+	// Constructor - pass in the grid to search over
+	Pathfinder(Grid* grid);
+	~Pathfinder();
+
+	// Run a full search from the start cell to the end cell
+	// Returns true and fills in the path (start to end) if one was found
+	bool FindPath(int start, int end, std::vector<int>* path);
+
+	// Start a new search from the start cell to the end cell
+	void Begin(int start, int end);
+	// Expand a single cell, returning the status of the search afterwards
+	SearchStatus Step();
+	// Expand cells until the search finishes or a budget runs out, returning the status of the search afterwards
+	// A budget of 0 means no limit, so Advance(0, 0) runs to completion and Advance(1, 0) is the same as Step
+	// Time is only checked every few expansions, so a time budget can be overrun by a handful of cells
+	SearchStatus Advance(int maxExpansions, int maxMicroseconds);
+	// Clear all search state; only the open sets are touched, as old cell state is ignored once the generation moves on
+	// Node pages stay allocated between searches; they're only freed when the generation counter wraps
+	void Reset();
+	// Trace back from the end cell to get the path (start to end), if one was found
+	// Jumps made by JPS and JPS+ are filled in, so the path always moves one cell at a time
+	// For ARA* this is the best path found so far, which is available while the search carries on improving it
+	bool GetPath(std::vector<int>* path);
+
+	SearchStatus GetStatus() { return status; }
+	// Get the number of paths the current search has found; ARA* finds a shorter path on each pass, other searches find at most one
+	// An ARA* search has a path as soon as its first pass finishes, while it's still running to improve on it
+	int GetSolutionCount() { return mode == SEARCH_MODE_ANYTIME ? solutionCount : (status == SEARCH_FOUND ? 1 : 0); }
+	// Get the cost of the path found by the last search (the best so far for a running ARA* search), -1 if none was found
+	int GetPathCost() { return GetSolutionCount() > 0 ? pathCost : -1; }
+	// Get the most times longer than the shortest path the path found can be; 1 for searches that always find the shortest path
+	// Only holds with a heuristic that never overestimates (octile, Euclidean or Chebyshev)
+	double GetSuboptimalityBound() { return suboptimalityBound; }
+	// Get the number of cells expanded by the current search, for comparing search modes
+	int GetExpansionCount() { return expansionCount; }
+	// Get the counters and phase timers for the current search; how much is gathered depends on PATHFINDER_STATS
+	SearchStats GetStats() { SearchStats current = stats; current.expansions = expansionCount; return current; }
+	// Get every cell the current search has written state to, in the order they were first reached
+	const std::vector<int>& GetTouchedCells() { return touchedCells; }
+
+	// Set the heuristic used to estimate the distance to the end cell; takes effect on the next search
+	void SetHeuristic(HeuristicType heuristic) { this->heuristic = heuristic; }
+	HeuristicType GetHeuristic() { return heuristic; }
+
+	// Set the way the grid is searched; takes effect on the next search
+	void SetSearchMode(SearchMode mode) { this->mode = mode; }
+	SearchMode GetSearchMode() { return mode; }
+	// Set the weight weighted A* multiplies the heuristic by, and the weight ARA* starts at; takes effect on the next search
+	// Weights below 1 are treated as 1
+	void SetHeuristicWeight(double weight) { heuristicWeight = weight; }
+	double GetHeuristicWeight() { return heuristicWeight; }
+	// Use a jump point table shared with other pathfinders for JPS+, or NULL to go back to this pathfinder's own table
+	// Shared tables aren't rebuilt automatically; whoever owns the table must keep it up to date with the grid
+	// A JPS+ search runs as plain JPS whenever its table isn't up to date, e.g. because the grid is too large for one
+	void SetJumpPointTable(JumpPointTable* table);
+	// Use region labels to reject unreachable queries before expanding anything, or NULL (the default) to search them out
+	// The labels aren't rebuilt automatically and are only used while they're up to date, so whoever owns them should build them
+	// and keep them current with ConnectedComponents::UpdateCell; they can be shared between any number of pathfinders
+	void SetComponents(ConnectedComponents* components);
+
+	// Set whether closed cells can be moved back to the open set when a cheaper route to them is found
+	// Reopening can safely be disabled when the heuristic is consistent, as closed cells then already have their lowest cost
+	void SetReopening(bool allowReopening) { this->allowReopening = allowReopening; }
+
+	// Per-cell search state, used to visualise the search; cells the current search hasn't reached report blank state
+	// Bidirectional searches report the forward search's state where both directions have reached a cell
+	bool IsOpen(int index) { return (IsCurrent(forward, index) && forward.nodes.Get(index).isOpen) || (IsCurrent(backward, index) && backward.nodes.Get(index).isOpen); }
+	bool IsClosed(int index) { return (IsCurrent(forward, index) && forward.nodes.Get(index).isClosed) || (IsCurrent(backward, index) && backward.nodes.Get(index).isClosed); }
+	int GetGCost(int index) { return IsCurrent(forward, index) ? forward.nodes.Get(index).gCost : (IsCurrent(backward, index) ? backward.nodes.Get(index).gCost : 0); }
+	int GetFCost(int index) { return IsCurrent(forward, index) ? forward.nodes.Get(index).fCost : (IsCurrent(backward, index) ? backward.nodes.Get(index).fCost : 0); }
+	int GetParent(int index) { return IsCurrent(forward, index) ? forward.nodes.Get(index).parent : -1; }
+
+private:
+
+	// Search state for a single cell
+	struct Node
+	{
+		// Distance from the cell this direction started at to this cell
+		int gCost;
+		// Estimated distance from this cell to the cell this direction is searching towards
+		int hCost;
+		// Summed distance
+		int fCost;
+		// Cell this one was reached from, -1 if none
+		int parent;
+		// The search that last wrote to this cell; the rest of the state is stale if this isn't the current generation
+		unsigned int generation;
+		// Which set the cell is currently in
+		bool isOpen;
+		bool isClosed;
+		// Set for ARA* when a closed cell's cost is lowered, so it's moved back to the open set at the start of the next pass
+		bool isInconsistent;
+		// Set for ARA* on cells closed in an earlier pass, which keep their costs and are only opened again if they're lowered
+		bool isSettled;
+	};
+
+	// Search state for one direction of the search; only bidirectional searches use the backward frontier
+	struct Frontier
+	{
+		Frontier(int cellCount) : nodes(cellCount, Node()), openSet(cellCount) {}
+
+		// Paged, so a search only allocates state for the parts of the grid it reaches
+		PagedArray<Node> nodes;
+		OpenSet openSet;
+		// Grid coordinates of the cell this direction is searching towards, cached for the heuristic
+		int targetX;
+		int targetY;
+	};
+
+	// Get whether a cell's state was written by the current search
+	bool IsCurrent(Frontier& frontier, int index) { return frontier.nodes.Get(index).generation == generation; }
+	// Get a cell's search state, clearing it first if it was last written by an earlier search
+	Node& GetNode(Frontier& frontier, int index);
+	// Estimate the distance from a cell to the cell a frontier is searching towards
+	int Heuristic(Frontier& frontier, int index);
+
+	// Expand one cell from whichever direction has the higher lowest f-cost
+	SearchStatus StepBidirectional();
+	// Expand one cell of the current ARA* pass, finishing the pass once nothing left could give a shorter path to the end cell
+	SearchStatus StepAnytime();
+	// Keep the path from a finished ARA* pass, then lower the weight and set the open set up for the next pass
+	void FinishPass();
+	// Record a cell as the meeting point if both directions have reached it and it gives a cheaper path
+	void CheckMeeting(int index);
+	// Follow parent links from a cell back to the cell a frontier started at, appending each cell to the path
+	void TracePath(Frontier& frontier, int index, std::vector<int>* path);
+
+	// Find the costs for a cell and add or move it into the open set
+	void OpenNode(Frontier& frontier, int index, int gCost, int parent);
+	// Update a neighbour reached from a cell if the new g-cost is an improvement
+	void UpdateNeighbour(Frontier& frontier, int index, int neighbour, int newGCost);
+	// Search a cell's neighbourhood for cells that need to be updated
+	void SearchNeighbourhood(Frontier& frontier, int index);
+	// Search from a cell along each direction that JPS doesn't prune, adding the jump points found
+	void SearchJumpPoints(int index);
+	// Find the directions JPS needs to search from a cell, given the direction it was reached from
+	int FindJumpDirections(int index, int* directions);
+	// Move from a cell in a direction until a jump point is found, returning it or -1 if a wall is hit first
+	int Jump(int x, int y, int directionX, int directionY);
+	// Jump along a row or column, reading the grid's bit layers 64 cells at a time instead of cell by cell
+	int JumpStraight(int x, int y, int directionX, int directionY);
+	// Read 64 cells of a row or column starting at a position along it, with bit i the cell i steps along in the given direction
+	uint64_t ReadLine(bool isRow, int line, int first, int step);
+	// Find the jump point in a direction from a cell using the precomputed table, returning it or -1 if there isn't one
+	int JumpFromTable(int index, int direction);
+
+	Grid* grid;
+
+	// Search from the start cell towards the end cell, and (for bidirectional searches) from the end cell towards the start cell
+	Frontier forward;
+	Frontier backward;
+
+	// Generation of the current search, and the cells it has written to
+	unsigned int generation;
+	std::vector<int> touchedCells;
+	// Jump distances for JPS+, either this pathfinder's own table (rebuilt when the grid changes) or a shared one
+	JumpPointTable ownJumpPoints;
+	JumpPointTable* jumpPoints;
+	// Whether the current search reads jumps from the table, which JPS+ searches only do while it's up to date
+	bool isJumpTableUsed;
+	// Region labels used to fail searches between cells that can't reach each other before expanding anything, NULL if not used
+	ConnectedComponents* components;
+
+	int startIndex;
+	int endIndex;
+	// Cell where the two directions of a bidirectional search meet on the best path found so far, -1 if they haven't met
+	int meetingIndex;
+	// Cost of the path found, or of the best path found so far by a bidirectional or ARA* search
+	int pathCost;
+	// Heuristic weight of the current search (or current ARA* pass), and the bound on the path found
+	double weight;
+	double suboptimalityBound;
+	// Paths found by the current ARA* search, and the latest of them, kept as the next pass rewrites the parent links
+	int solutionCount;
+	std::vector<int> anytimePath;
+	int expansionCount;
+	// Everything else counted or timed during the current search; the expansion count is always kept, so it lives outside
+	SearchStats stats;
+
+	SearchStatus status;
+
+	SearchMode mode;
+	HeuristicType heuristic;
+	double heuristicWeight;
+	bool allowReopening;
+
+};
+
+#endif
@@ -0,0 +1,80 @@
+// SearchStats.cpp
+
+#include "SearchStats.h"
+
+// Write a string as a quoted JSON string, escaping the characters JSON doesn't allow as they are
+static void WriteJsonString(std::ostream& stream, const char* text)
+{
+
+	stream << '"';
+
+	for (const char* character = text; *character != '\0'; character++)
+	{
+
+		if (*character == '"' || *character == '\\')
+		{
+
+			stream << '\\';
+
+		}
+
+		if ((unsigned char)*character >= 0x20)
+		{
+
+			stream << *character;
+
+		}
+
+	}
+
+	stream << '"';
+
+}
+
+// Set every counter and timer back to zero
+void ResetSearchStats(SearchStats* stats)
+{
+
+	stats->expansions = 0;
+	stats->insertions = 0;
+	stats->decreaseKeys = 0;
+	stats->reopens = 0;
+	stats->peakOpenSetSize = 0;
+
+	stats->setupNanoseconds = 0;
+	stats->selectNanoseconds = 0;
+	stats->expandNanoseconds = 0;
+	stats->traceNanoseconds = 0;
+
+}
+
+// Write the column names for WriteSearchStatsCsv
+void WriteSearchStatsCsvHeader(std::ostream& stream)
+{
+
+	stream << "label,expansions,insertions,decrease_keys,reopens,peak_open_set_size,setup_ns,select_ns,expand_ns,trace_ns\n";
+
+}
+
+// Write one search's stats as a CSV row
+void WriteSearchStatsCsv(std::ostream& stream, const char* label, const SearchStats& stats)
+{
+
+	stream << label << ',' << stats.expansions << ',' << stats.insertions << ',' << stats.decreaseKeys << ',' << stats.reopens << ',' <<
+		stats.peakOpenSetSize << ',' << stats.setupNanoseconds << ',' << stats.selectNanoseconds << ',' << stats.expandNanoseconds << ',' <<
+		stats.traceNanoseconds << '\n';
+
+}
+
+// Write one search's stats as a JSON object
+void WriteSearchStatsJson(std::ostream& stream, const char* label, const SearchStats& stats)
+{
+
+	stream << "{\"label\": ";
+	WriteJsonString(stream, label);
+	stream << ", \"expansions\": " << stats.expansions << ", \"insertions\": " << stats.insertions <<
+		", \"decrease_keys\": " << stats.decreaseKeys << ", \"reopens\": " << stats.reopens << ", \"peak_open_set_size\": " << stats.peakOpenSetSize <<
+		", \"setup_ns\": " << stats.setupNanoseconds << ", \"select_ns\": " << stats.selectNanoseconds << ", \"expand_ns\": " << stats.expandNanoseconds <<
+		", \"trace_ns\": " << stats.traceNanoseconds << "}";
+
+}
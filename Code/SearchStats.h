@@ -0,0 +1,81 @@
+// SearchStats - counters and phase timers gathered while a search runs, with CSV and JSON export
+// PATHFINDER_STATS picks how much is gathered when compiling: 0 removes everything, 1 (the default) keeps the counters,
+// and 2 also times each phase of the search; timing reads the clock around every expansion, so it's left off unless asked for
+
+#ifndef _SEARCHSTATS_H_
+#define _SEARCHSTATS_H_
+
+#include <chrono>
+#include <ostream>
+
+#ifndef PATHFINDER_STATS
+#define PATHFINDER_STATS 1
+#endif
+
+// What happened during a single search
+// Counters other than expansions stay at zero when PATHFINDER_STATS is 0, and timers stay at zero unless it's 2
+struct SearchStats
+{
+	// Cells taken from the open set and expanded
+	int expansions;
+	// Cells added to the open set for the first time in the search, or moved back into it after being closed
+	int insertions;
+	// Cells already in the open set given a lower cost
+	int decreaseKeys;
+	// Closed cells moved back to the open set because a cheaper route to them was found
+	int reopens;
+	// Largest number of cells in the open set (or both open sets, for bidirectional searches) at once
+	int peakOpenSetSize;
+
+	// Time spent in each phase, in nanoseconds: starting the search (including rebuilding any precomputed data),
+	// taking cells from the open set, expanding them (searching neighbours or jumping), and tracing the path back
+	long long setupNanoseconds;
+	long long selectNanoseconds;
+	long long expandNanoseconds;
+	long long traceNanoseconds;
+};
+
+// Set every counter and timer back to zero
+void ResetSearchStats(SearchStats* stats);
+
+// Write the column names for WriteSearchStatsCsv
+void WriteSearchStatsCsvHeader(std::ostream& stream);
+// Write one search's stats as a CSV row, with a label (e.g. the search mode) in the first column
+void WriteSearchStatsCsv(std::ostream& stream, const char* label, const SearchStats& stats);
+// Write one search's stats as a JSON object, including the label
+void WriteSearchStatsJson(std::ostream& stream, const char* label, const SearchStats& stats);
+
+#if PATHFINDER_STATS >= 1
+// Count an event
+#define STATS_COUNT(counter) ((counter)++)
+// Raise a peak to a new value if it's higher
+#define STATS_PEAK(peak, value) ((peak) = (value) > (peak) ? (value) : (peak))
+#else
+#define STATS_COUNT(counter) ((void)0)
+#define STATS_PEAK(peak, value) ((void)0)
+#endif
+
+#if PATHFINDER_STATS >= 2
+// Adds the time from its construction to the end of the enclosing scope onto a total, in nanoseconds
+class StatsTimer
+{
+
+public:
+
+	StatsTimer(long long* total) : total(total), start(std::chrono::steady_clock::now()) {}
+	~StatsTimer() { *total += std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() - start).count(); }
+
+private:
+
+	long long* total;
+	std::chrono::steady_clock::time_point start;
+
+};
+
+// Time the rest of the enclosing scope
+#define STATS_TIME_SCOPE(total) StatsTimer statsTimer(&(total))
+#else
+#define STATS_TIME_SCOPE(total) ((void)0)
+#endif
+
+#endif
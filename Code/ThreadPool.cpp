@@ -0,0 +1,197 @@
+// ThreadPool.cpp
+
+#include "ThreadPool.h"
+#include <algorithm>
+
+ThreadPool::ThreadPool(int threadCount)
+{
+
+	if (threadCount <= 0)
+	{
+
+		threadCount = std::max(1, (int)std::thread::hardware_concurrency());
+
+	}
+
+	queuedTasks = 0;
+	pendingTasks = 0;
+	nextQueue = 0;
+	isStopping = false;
+
+	for (int i = 0; i < threadCount; i++)
+	{
+
+		queues.push_back(std::unique_ptr<WorkerQueue>(new WorkerQueue()));
+
+	}
+
+	// Only start the workers once every queue exists, as they steal from each other
+	for (int i = 0; i < threadCount; i++)
+	{
+
+		threads.push_back(std::thread(&ThreadPool::WorkerLoop, this, i));
+
+	}
+
+}
+
+// Finish any queued tasks, then stop and join the workers
+ThreadPool::~ThreadPool()
+{
+
+	Wait();
+
+	{
+
+		std::lock_guard<std::mutex> lock(stateMutex);
+		isStopping = true;
+
+	}
+
+	workAvailable.notify_all();
+
+	for (std::thread& thread : threads)
+	{
+
+		thread.join();
+
+	}
+
+}
+
+// Queue a task, dealing it out to the next worker's queue in turn
+void ThreadPool::Submit(Task task)
+{
+
+	int queue = 0;
+
+	{
+
+		std::lock_guard<std::mutex> lock(stateMutex);
+
+		pendingTasks++;
+
+		queue = nextQueue;
+		nextQueue = (nextQueue + 1) % (int)queues.size();
+
+	}
+
+	{
+
+		std::lock_guard<std::mutex> lock(queues[queue]->mutex);
+		queues[queue]->tasks.push_back(task);
+
+	}
+
+	{
+
+		std::lock_guard<std::mutex> lock(stateMutex);
+		queuedTasks++;
+
+	}
+
+	workAvailable.notify_one();
+
+}
+
+// Block until every submitted task has finished
+void ThreadPool::Wait()
+{
+
+	std::unique_lock<std::mutex> lock(stateMutex);
+
+	workFinished.wait(lock, [this] { return pendingTasks == 0; });
+
+}
+
+// Run tasks until the pool is destroyed, sleeping whenever every queue is empty
+void ThreadPool::WorkerLoop(int worker)
+{
+
+	while (true)
+	{
+
+		Task task;
+
+		if (TakeTask(worker, &task))
+		{
+
+			task(worker);
+
+			std::lock_guard<std::mutex> lock(stateMutex);
+
+			pendingTasks--;
+
+			if (pendingTasks == 0)
+			{
+
+				workFinished.notify_all();
+
+			}
+
+			continue;
+
+		}
+
+		std::unique_lock<std::mutex> lock(stateMutex);
+
+		workAvailable.wait(lock, [this] { return queuedTasks > 0 || isStopping; });
+
+		if (isStopping && queuedTasks <= 0)
+		{
+
+			return;
+
+		}
+
+	}
+
+}
+
+// Take the newest task from the worker's own queue, or steal the oldest task from another worker
+bool ThreadPool::TakeTask(int worker, Task* task)
+{
+
+	int queueCount = (int)queues.size();
+
+	for (int i = 0; i < queueCount; i++)
+	{
+
+		WorkerQueue& queue = *queues[(worker + i) % queueCount];
+
+		std::unique_lock<std::mutex> queueLock(queue.mutex);
+
+		if (queue.tasks.empty())
+		{
+
+			continue;
+
+		}
+
+		if (i == 0)
+		{
+
+			*task = queue.tasks.back();
+			queue.tasks.pop_back();
+
+		}
+		else
+		{
+
+			*task = queue.tasks.front();
+			queue.tasks.pop_front();
+
+		}
+
+		queueLock.unlock();
+
+		std::lock_guard<std::mutex> lock(stateMutex);
+		queuedTasks--;
+
+		return true;
+
+	}
+
+	return false;
+
+}
@@ -0,0 +1,67 @@
+// ThreadPool class - fixed set of worker threads with work stealing
+// Each worker has its own task queue; tasks are dealt out to the queues in turn, and workers that run out steal from the others
+// Tasks are passed the index of the worker running them, so callers can keep per-worker scratch data
+
+#ifndef _THREADPOOL_H_
+#define _THREADPOOL_H_
+
+#include <condition_variable>
+#include <deque>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+class ThreadPool
+{
+
+public:
+
+	// A task, called with the index of the worker running it
+	typedef std::function<void(int)> Task;
+
+	// Constructor - pass in the number of worker threads, or 0 to use one per hardware thread
+	ThreadPool(int threadCount);
+	~ThreadPool();
+
+	int GetThreadCount() { return (int)threads.size(); }
+
+	// Queue a task to be run by one of the workers
+	void Submit(Task task);
+	// Block until every submitted task has finished
+	void Wait();
+
+private:
+
+	// A worker's task queue; the owner takes from the back, thieves take from the front
+	struct WorkerQueue
+	{
+		std::mutex mutex;
+		std::deque<Task> tasks;
+	};
+
+	// Run tasks until the pool is destroyed
+	void WorkerLoop(int worker);
+	// Take a task from the worker's own queue, or steal one from another worker if it's empty
+	bool TakeTask(int worker, Task* task);
+
+	std::vector<std::thread> threads;
+	std::vector<std::unique_ptr<WorkerQueue> > queues;
+
+	// Guards the counters below, and is used to put idle workers to sleep
+	std::mutex stateMutex;
+	std::condition_variable workAvailable;
+	std::condition_variable workFinished;
+
+	// Tasks sitting in a queue waiting for a worker
+	int queuedTasks;
+	// Tasks that have been submitted but haven't finished yet
+	int pendingTasks;
+	// The queue the next submitted task goes to
+	int nextQueue;
+	bool isStopping;
+
+};
+
+#endif